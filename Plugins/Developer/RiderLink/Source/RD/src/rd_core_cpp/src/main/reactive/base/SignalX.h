@@ -10,6 +10,9 @@
 #include <utility>
 #include <functional>
 #include <atomic>
+#include <algorithm>
+#include <deque>
+#include <vector>
 
 namespace rd
 {
@@ -38,6 +41,8 @@ private:
 		}
 
 		Event(Event&&) = default;
+
+		Event& operator=(Event&&) = default;
 		// endregion
 
 		bool is_alive() const
@@ -45,44 +50,182 @@ private:
 			return !lifetime->is_terminated();
 		}
 
-		void execute_if_alive(T const& value) const
+		// a dropped event is a tombstone, its handler is released and it's skipped until compaction
+		bool is_dropped() const
 		{
-			if (is_alive())
+			return !action;
+		}
+
+		void drop()
+		{
+			action = nullptr;
+		}
+
+		void execute(T const& value) const
+		{
+			action(value);
+		}
+	};
+
+	/**
+	 * \brief Listeners in the order of advising, the first one inline and the rest in a vector, so firing a signal
+	 * with a single listener touches no heap. Listeners found dead by [fire] become tombstones, which are compacted
+	 * away once there are [COMPACTION_THRESHOLD] of them and they make up half of the listeners. Nothing moves while a
+	 * handler runs: listeners advised meanwhile wait in [pending], where nested fires reach them, and are appended
+	 * once the outermost fire is through the others.
+	 */
+	class Listeners
+	{
+	private:
+		static constexpr size_t COMPACTION_THRESHOLD = 8;
+
+		optional<Event> first;
+		std::vector<Event> rest;
+		// a deque keeps the events in place while their handlers run and advise more
+		std::deque<Event> pending;
+		int32_t firing = 0;
+		size_t dead = 0;
+
+		size_t size() const
+		{
+			return (first ? 1 : 0) + rest.size();
+		}
+
+		Event& at(size_t i)
+		{
+			return i == 0 ? *first : rest[i - 1];
+		}
+
+		void push(Event&& event)
+		{
+			if (!first)
 			{
-				action(value);
+				first.emplace(std::move(event));
+			}
+			else
+			{
+				rest.push_back(std::move(event));
 			}
 		}
-	};
 
-	using counter_t = int32_t;
-	using listeners_t = std::map<counter_t, Event>;
+		void append_pending()
+		{
+			for (auto& event : pending)
+			{
+				push(std::move(event));
+			}
+			pending.clear();
+		}
 
-	mutable counter_t advise_id = 0;
-	mutable listeners_t listeners, priority_listeners;
+		void compact()
+		{
+			rest.erase(std::remove_if(rest.begin(), rest.end(), [](Event const& e) { return e.is_dropped(); }), rest.end());
+			if (first && first->is_dropped())
+			{
+				if (rest.empty())
+				{
+					first.reset();
+				}
+				else
+				{
+					*first = std::move(rest.front());
+					rest.erase(rest.begin());
+				}
+			}
+			dead = 0;
+		}
 
-	static void cleanup(listeners_t& queue)
-	{
-		util::erase_if(queue, [](Event const& e) -> bool { return !e.is_alive(); });
-	}
+		// keeps [firing] right if a handler throws
+		class FiringScope
+		{
+			int32_t& firing;
 
-	void fire_impl(T const& value, listeners_t& queue) const
-	{
-		for (auto const& p : queue)
+		public:
+			explicit FiringScope(int32_t& firing) : firing(++firing)
+			{
+			}
+
+			FiringScope(FiringScope const&) = delete;
+
+			~FiringScope()
+			{
+				--firing;
+			}
+		};
+
+		void fire_one(Event& event, T const& value)
 		{
-			auto const& event = p.second;
-			event.execute_if_alive(value);
+			if (event.is_dropped())
+			{
+				return;
+			}
+			if (!event.is_alive())
+			{
+				// a nested fire leaves it to the outer one, the handler may be running there
+				if (firing == 1)
+				{
+					event.drop();
+					++dead;
+				}
+				return;
+			}
+			event.execute(value);
 		}
-		cleanup(queue);
-	}
+
+	public:
+		void add(Event&& event)
+		{
+			if (firing > 0)
+			{
+				pending.push_back(std::move(event));
+			}
+			else
+			{
+				push(std::move(event));
+			}
+		}
+
+		void fire(T const& value)
+		{
+			{
+				FiringScope scope(firing);
+				// only the outermost fire moves pending listeners in, nested ones reach them where they are
+				for (size_t i = 0;; ++i)
+				{
+					if (i == size() && firing == 1 && !pending.empty())
+					{
+						append_pending();
+					}
+					if (i < size())
+					{
+						fire_one(at(i), value);
+					}
+					else if (i - size() < pending.size())
+					{
+						fire_one(pending[i - size()], value);
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+
+			if (firing == 0 && dead >= COMPACTION_THRESHOLD && dead * 2 >= size())
+			{
+				compact();
+			}
+		}
+	};
+
+	mutable Listeners listeners, priority_listeners;
 
 	template <typename F>
-	void advise0(const Lifetime& lifetime, F&& handler, listeners_t& queue) const
+	void advise0(const Lifetime& lifetime, F&& handler, Listeners& queue) const
 	{
 		if (lifetime->is_terminated())
 			return;
-		counter_t id = advise_id /*.load()*/;
-		queue.emplace(id, Event(std::forward<F>(handler), lifetime));
-		++advise_id;
+		queue.add(Event(std::forward<F>(handler), lifetime));
 	}
 
 public:
@@ -106,8 +249,8 @@ public:
 
 	void fire(T const& value) const override
 	{
-		fire_impl(value, priority_listeners);
-		fire_impl(value, listeners);
+		priority_listeners.fire(value);
+		listeners.fire(value);
 	}
 
 	using ISignal<T>::advise;
@@ -0,0 +1,157 @@
+#ifndef RD_CPP_SMALL_TASK_H
+#define RD_CPP_SMALL_TASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Move-only `void()` action that keeps callables up to [INLINE_SIZE] bytes in place, so queueing a lambda
+ * that captures a couple of pointers and a Buffer allocates nothing. Bigger callables are moved to the heap.
+ * Unlike std::function it doesn't require the callable to be copyable.
+ */
+class small_task
+{
+public:
+	static constexpr size_t INLINE_SIZE = 64;
+
+private:
+	struct ops
+	{
+		void (*invoke)(void* storage);
+		void (*move)(void* from, void* to) noexcept;
+		void (*destroy)(void* storage) noexcept;
+	};
+
+	template <typename F>
+	struct inline_ops
+	{
+		static void invoke(void* storage)
+		{
+			(*static_cast<F*>(storage))();
+		}
+
+		static void move(void* from, void* to) noexcept
+		{
+			new (to) F(std::move(*static_cast<F*>(from)));
+			static_cast<F*>(from)->~F();
+		}
+
+		static void destroy(void* storage) noexcept
+		{
+			static_cast<F*>(storage)->~F();
+		}
+
+		static constexpr ops table{&invoke, &move, &destroy};
+	};
+
+	template <typename F>
+	struct heap_ops
+	{
+		static void invoke(void* storage)
+		{
+			(**static_cast<F**>(storage))();
+		}
+
+		static void move(void* from, void* to) noexcept
+		{
+			*static_cast<F**>(to) = *static_cast<F**>(from);
+		}
+
+		static void destroy(void* storage) noexcept
+		{
+			delete *static_cast<F**>(storage);
+		}
+
+		static constexpr ops table{&invoke, &move, &destroy};
+	};
+
+	template <typename F>
+	static constexpr bool fits_inline = sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+										std::is_nothrow_move_constructible<F>::value;
+
+	alignas(std::max_align_t) unsigned char storage[INLINE_SIZE];
+	ops const* table = nullptr;
+
+	void reset() noexcept
+	{
+		if (table != nullptr)
+		{
+			table->destroy(storage);
+			table = nullptr;
+		}
+	}
+
+public:
+	// region ctor/dtor
+
+	small_task() noexcept = default;
+
+	template <typename F, typename D = std::decay_t<F>, typename = std::enable_if_t<!std::is_same<D, small_task>::value>>
+	small_task(F&& f)
+	{
+		if constexpr (fits_inline<D>)
+		{
+			new (storage) D(std::forward<F>(f));
+			table = &inline_ops<D>::table;
+		}
+		else
+		{
+			*reinterpret_cast<D**>(storage) = new D(std::forward<F>(f));
+			table = &heap_ops<D>::table;
+		}
+	}
+
+	small_task(small_task&& other) noexcept : table(other.table)
+	{
+		if (table != nullptr)
+		{
+			table->move(other.storage, storage);
+			other.table = nullptr;
+		}
+	}
+
+	small_task& operator=(small_task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			if (other.table != nullptr)
+			{
+				other.table->move(other.storage, storage);
+				table = other.table;
+				other.table = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	small_task(small_task const&) = delete;
+
+	small_task& operator=(small_task const&) = delete;
+
+	~small_task()
+	{
+		reset();
+	}
+	// endregion
+
+	explicit operator bool() const noexcept
+	{
+		return table != nullptr;
+	}
+
+	void operator()()
+	{
+		table->invoke(storage);
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_SMALL_TASK_H
@@ -2,6 +2,8 @@
 
 #include "protocol/Buffer.h"
 
+#include "util/byte_array_pool.h"
+
 #include <string>
 #include <algorithm>
 
@@ -19,6 +21,23 @@ Buffer::Buffer(ByteArray array, size_t offset) : data_(std::move(array)), offset
 {
 }
 
+Buffer::~Buffer()
+{
+	if (pooled_ && data_.capacity() > 0)
+	{
+		util::byte_array_pool::release(std::move(data_));
+	}
+}
+
+Buffer Buffer::from_pool(size_t initial_size)
+{
+	static_assert(std::is_same<ByteArray, util::byte_array_pool::byte_array>::value, "pool keeps arrays of another type");
+
+	Buffer result(util::byte_array_pool::acquire(initial_size));
+	result.pooled_ = true;
+	return result;
+}
+
 size_t Buffer::get_position() const
 {
 	return offset;
@@ -61,7 +80,17 @@ void Buffer::require_available(size_t moreSize)
 	if (offset + moreSize >= size())
 	{
 		const size_t new_size = (std::max)(size() * 2, offset + moreSize);
-		data_.resize(new_size);
+		if (pooled_)
+		{
+			ByteArray grown = util::byte_array_pool::acquire(new_size);
+			std::copy(data_.begin(), data_.end(), grown.begin());
+			util::byte_array_pool::release(std::move(data_));
+			data_ = std::move(grown);
+		}
+		else
+		{
+			data_.resize(new_size);
+		}
 	}
 }
 
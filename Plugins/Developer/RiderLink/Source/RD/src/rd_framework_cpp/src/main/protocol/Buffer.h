@@ -46,6 +46,9 @@ private:
 
 	size_t offset = 0;
 
+	// data_ is borrowed from util::byte_array_pool, grows within it and goes back to it unless moved out
+	bool pooled_ = false;
+
 	// read
 	void read(word_t* dst, size_t size);
 
@@ -71,6 +74,13 @@ public:
 
 	Buffer& operator=(Buffer&&) noexcept = default;
 
+	~Buffer();
+
+	/**
+	 * \brief Buffer for a message that is sent and dropped once acknowledged, see util::byte_array_pool.
+	 */
+	static Buffer from_pool(size_t initial_size = 0);
+
 	// endregion
 
 	size_t get_position() const;
@@ -14,6 +14,51 @@ static void execute(const IRdReactive* that, Buffer msg)
 	that->on_wire_received(std::move(msg));
 }
 
+constexpr unsigned SubscriptionTable::SHARD_BITS;
+constexpr size_t SubscriptionTable::SHARD_COUNT;
+
+size_t SubscriptionTable::shard_index(RdId const& id)
+{
+	const uint64_t h = static_cast<uint64_t>(rd::hash<RdId>()(id));
+	return static_cast<size_t>(((h ^ (h >> 32)) * 0x9E3779B97F4A7C15ull) >> (64 - SHARD_BITS));
+}
+
+SubscriptionTable::Shard& SubscriptionTable::shard(RdId const& id)
+{
+	return shards[shard_index(id)];
+}
+
+SubscriptionTable::Shard const& SubscriptionTable::shard(RdId const& id) const
+{
+	return shards[shard_index(id)];
+}
+
+RdReactiveBase const* SubscriptionTable::find(RdId const& id) const
+{
+	Shard const& s = shard(id);
+	std::shared_lock<decltype(s.lock)> guard(s.lock);
+	auto it = s.entities.find(id);
+	return it == s.entities.end() ? nullptr : it->second;
+}
+
+void SubscriptionTable::insert(RdId const& id, RdReactiveBase const* entity)
+{
+	Shard& s = shard(id);
+	std::unique_lock<decltype(s.lock)> guard(s.lock);
+	s.entities[id] = entity;
+}
+
+void SubscriptionTable::erase(RdId const& id, RdReactiveBase const* entity)
+{
+	Shard& s = shard(id);
+	std::unique_lock<decltype(s.lock)> guard(s.lock);
+	auto it = s.entities.find(id);
+	if (it != s.entities.end() && it->second == entity)
+	{
+		s.entities.erase(it);
+	}
+}
+
 void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) const
 {
 	if (sync)
@@ -23,12 +68,7 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 	else
 	{
 		auto action = [this, that, message = std::move(msg)]() mutable {
-			bool exists_id = false;
-			{
-				std::lock_guard<decltype(lock)> guard(lock);
-				exists_id = subscriptions.count(that->get_id()) > 0;
-			}
-			if (exists_id)
+			if (subscriptions.find(that->get_id()) != nullptr)
 			{
 				execute(that, std::move(message));
 			}
@@ -37,8 +77,7 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 				logger->trace("Disappeared Handler for Reactive entities with id: {}", to_string(that->get_id()));
 			}
 		};
-		std::function<void()> function = util::make_shared_function(std::move(action));
-		that->get_wire_scheduler()->queue(std::move(function));
+		that->get_wire_scheduler()->queue_task(std::move(action));
 	}
 }
 
@@ -50,9 +89,17 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 {
 	RD_ASSERT_MSG(!id.isNull(), "id mustn't be null")
 
+	RdReactiveBase const* s = subscriptions.find(id);
+	// the broker's queues only keep the order of messages for in-order custom schedulers
+	if (s != nullptr && (s->get_wire_scheduler() == default_scheduler || s->get_wire_scheduler()->out_of_order_execution))
+	{
+		invoke(s, std::move(message));
+		return;
+	}
+
 	{	 // synchronized recursively
 		std::lock_guard<decltype(lock)> guard(lock);
-		RdReactiveBase const* s = subscriptions[id];
+		s = subscriptions.find(id);
 		if (s == nullptr)
 		{
 			auto it = broker.find(id);
@@ -61,19 +108,20 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 				it = broker.emplace(id, Mq{}).first;
 			}
 
-			broker[id].default_scheduler_messages.emplace(std::move(message));
+			// unlike iterators, references to the elements survive a rehash
+			Mq& mq = it->second;
+			mq.default_scheduler_messages.emplace(std::move(message));
 
-			auto action = [this, it, id]() mutable {
-				auto& current = it->second;
-				RdReactiveBase const* subscription = subscriptions[id];
+			auto action = [this, &mq, id]() mutable {
+				RdReactiveBase const* subscription = subscriptions.find(id);
 
 				optional<Buffer> message;
 				{
 					std::lock_guard<decltype(lock)> guard(lock);
-					if (!current.default_scheduler_messages.empty())
+					if (!mq.default_scheduler_messages.empty())
 					{
-						message = make_optional<Buffer>(std::move(current.default_scheduler_messages.front()));
-						current.default_scheduler_messages.pop();
+						message = make_optional<Buffer>(std::move(mq.default_scheduler_messages.front()));
+						mq.default_scheduler_messages.pop();
 					}
 				}
 				if (subscription != nullptr)
@@ -88,10 +136,12 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 					logger->trace("No handler for id: {}", to_string(id));
 				}
 
-				if (current.default_scheduler_messages.empty())
+				std::lock_guard<decltype(lock)> guard(lock);
+				if (mq.default_scheduler_messages.empty())
 				{
-					auto t = std::move(broker[id]);
+					auto t = std::move(mq);
 					broker.erase(id);
+					// queued under the lock, so messages dispatched after the erase can't overtake them
 					for (auto& it : t.custom_scheduler_messages)
 					{
 						RD_ASSERT_MSG(subscription->get_wire_scheduler() != default_scheduler,
@@ -100,13 +150,13 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 					}
 				}
 			};
-			std::function<void()> function = util::make_shared_function(std::move(action));
-			default_scheduler->queue(std::move(function));
+			default_scheduler->queue_task(std::move(action));
 		}
 		else
 		{
 			if (s->get_wire_scheduler() == default_scheduler || s->get_wire_scheduler()->out_of_order_execution)
 			{
+				// bound since the lookup above
 				invoke(s, std::move(message));
 			}
 			else
@@ -124,8 +174,6 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 			}
 		}
 	}
-
-	//        }
 }
 
 void MessageBroker::advise_on(Lifetime lifetime, RdReactiveBase const* entity) const
@@ -135,12 +183,11 @@ void MessageBroker::advise_on(Lifetime lifetime, RdReactiveBase const* entity) c
 	// advise MUST happen under default scheduler, not custom
 	default_scheduler->assert_thread();
 
-	std::lock_guard<decltype(lock)> guard(lock);
 	if (!lifetime->is_terminated())
 	{
 		auto key = entity->get_id();
-		subscriptions[key] = entity;
-		lifetime->add_action([this, key]() { subscriptions.erase(key); });
+		subscriptions.insert(key, entity);
+		lifetime->add_action([this, key, entity]() { subscriptions.erase(key, entity); });
 	}
 }
 }	 // namespace rd
@@ -12,7 +12,9 @@
 
 #include "spdlog/spdlog.h"
 
+#include <array>
 #include <queue>
+#include <shared_mutex>
 
 #include <rd_framework_export.h>
 
@@ -40,11 +42,51 @@ public:
 	std::vector<Buffer> custom_scheduler_messages;
 };
 
+/**
+ * \brief Entities by id, looked up for every received message and changed only when entities bind or unbind.
+ * Ids are spread over shards with a reader-writer lock each, so lookups share their lock with each other and only
+ * wait for a bind or unbind of an id in the same shard.
+ */
+class RD_FRAMEWORK_API SubscriptionTable
+{
+	static constexpr unsigned SHARD_BITS = 5;
+	static constexpr size_t SHARD_COUNT = size_t(1) << SHARD_BITS;
+
+	struct Shard
+	{
+		mutable std::shared_mutex lock;
+		rd::unordered_map<RdId, RdReactiveBase const*> entities;
+	};
+
+	std::array<Shard, SHARD_COUNT> shards;
+
+	// takes the shard from the high bits of the mixed hash, the maps inside a shard bucket by the low bits
+	static size_t shard_index(RdId const& id);
+
+	Shard& shard(RdId const& id);
+
+	Shard const& shard(RdId const& id) const;
+
+public:
+	/**
+	 * \return nullptr if no entity is bound to [id]
+	 */
+	RdReactiveBase const* find(RdId const& id) const;
+
+	void insert(RdId const& id, RdReactiveBase const* entity);
+
+	/**
+	 * \brief Unbinds [id] if it is still bound to [entity] and not to an entity that took the id over since.
+	 */
+	void erase(RdId const& id, RdReactiveBase const* entity);
+};
+
 class RD_FRAMEWORK_API MessageBroker final
 {
 private:
 	IScheduler* default_scheduler = nullptr;
-	mutable rd::unordered_map<RdId, RdReactiveBase const*> subscriptions;
+	mutable SubscriptionTable subscriptions;
+	// messages for ids nobody is bound to yet, guarded by [lock]
 	mutable rd::unordered_map<RdId, Mq> broker;
 
 	mutable std::recursive_mutex lock;
@@ -2,8 +2,6 @@
 
 #include <utility>
 
-#include "ctpl_stl.h"
-
 namespace rd
 {
 SingleThreadScheduler::SingleThreadScheduler(Lifetime lifetime, std::string name)
@@ -12,7 +10,7 @@ SingleThreadScheduler::SingleThreadScheduler(Lifetime lifetime, std::string name
 	lifetime->add_action([this]() {
 		try
 		{
-			pool->stop(true);
+			stop();
 		}
 		catch (std::exception const& e)
 		{
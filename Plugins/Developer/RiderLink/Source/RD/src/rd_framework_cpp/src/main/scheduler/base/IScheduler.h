@@ -6,6 +6,8 @@
 #pragma warning(disable:4251)
 #endif
 
+#include "util/small_task.h"
+
 #include <functional>
 #include <thread>
 
@@ -36,6 +38,12 @@ public:
 	 */
 	virtual void queue(std::function<void()> action) = 0;
 
+	/**
+	 * \brief Queues a move-only [task]. Schedulers that keep their own queue override it to take the task as is,
+	 * the default wraps it into a std::function.
+	 */
+	virtual void queue_task(util::small_task task);
+
 	// TO-DO
 	bool out_of_order_execution = false;
 
@@ -1,55 +1,167 @@
 #include "SingleThreadSchedulerBase.h"
 
 #include "util/core_util.h"
+#include "util/thread_util.h"
+
+#include <algorithm>
 
-#include "ctpl_stl.h"
 #include "spdlog/include/spdlog/sinks/stdout_color_sinks.h"
 
 namespace rd
 {
-SingleThreadSchedulerBase::PoolTask::PoolTask(std::function<void()> f, SingleThreadSchedulerBase* scheduler)
-	: f(std::move(f)), scheduler(scheduler)
+SingleThreadSchedulerBase::SingleThreadSchedulerBase(std::string name)
+	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic)), name(std::move(name))
 {
+	worker = std::thread([this]() { run(); });
+	thread_id = worker.get_id();
 }
 
-void SingleThreadSchedulerBase::PoolTask::operator()(int id) const
+void SingleThreadSchedulerBase::run()
 {
-	try
+	util::set_thread_name(name.c_str());
+
+	// returned to the free list when the next batch is taken, under the same lock
+	TaskNode* executed = nullptr;
+	TaskNode* executed_last = nullptr;
+	size_t executed_count = 0;
+	while (true)
 	{
-		f();
-		--scheduler->tasks_executing;
+		TaskNode* batch = nullptr;
+		std::chrono::steady_clock::time_point queued_at;
+		{
+			std::unique_lock<decltype(queue_lock)> guard(queue_lock);
+			if (executed != nullptr)
+			{
+				executed_last->next = free_nodes;
+				free_nodes = executed;
+				executed = nullptr;
+				tasks_executing -= static_cast<uint32_t>(executed_count);
+				if (tasks_executing == 0)
+				{
+					flush_cv.notify_all();
+				}
+			}
+			queue_cv.wait(guard, [this]() -> bool { return head != nullptr || stopping; });
+			if (head == nullptr)
+			{
+				return;
+			}
+			batch = head;
+			head = tail = nullptr;
+			queued_at = batch_queued_at;
+		}
+
+		executed = batch;
+		executed_last = run_batch(batch, queued_at, executed_count);
 	}
-	catch (std::exception const& e)
+}
+
+SingleThreadSchedulerBase::TaskNode* SingleThreadSchedulerBase::run_batch(
+	TaskNode* batch, std::chrono::steady_clock::time_point queued_at, size_t& count)
+{
+	using clock = std::chrono::steady_clock;
+
+	const clock::time_point batch_start = clock::now();
+	const duration_t latency = batch_start - queued_at;
+
+	count = 0;
+	TaskNode* last = batch;
+	for (TaskNode* node = batch; node != nullptr; node = node->next)
 	{
-		scheduler->log->error("Background task failed, scheduler={}, thread_id={} | {}", scheduler->name, id, e.what());
-		--scheduler->tasks_executing;
+		try
+		{
+			node->task();
+		}
+		catch (std::exception const& e)
+		{
+			log->error("Background task failed, scheduler={} | {}", name, e.what());
+		}
+		catch (...)
+		{
+			log->error("Background task failed with an unknown exception, scheduler={}", name);
+		}
+		// captures are released before the lock is taken again
+		node->task = util::small_task();
+
+		last = node;
+		++count;
 	}
+	const clock::time_point batch_end = clock::now();
+
+	std::lock_guard<decltype(stats_lock)> guard(stats_lock);
+	stats.tasks += count;
+	++stats.batches;
+	stats.max_batch = (std::max)(stats.max_batch, count);
+	stats.total_latency += latency;
+	stats.max_latency = (std::max)(stats.max_latency, latency);
+	stats.busy_time += batch_end - batch_start;
+	return last;
 }
 
-SingleThreadSchedulerBase::SingleThreadSchedulerBase(std::string name)
-	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic))
-	, name(std::move(name))
-	, pool(std::make_unique<ctpl::thread_pool>(1))
+void SingleThreadSchedulerBase::stop()
 {
-	RD_ASSERT_THROW_MSG(pool->size() == 1, "Thread pool wasn't properly initalized");
-	thread_id = pool->get_thread(0).get_id();
+	{
+		std::lock_guard<decltype(queue_lock)> guard(queue_lock);
+		stopping = true;
+	}
+	queue_cv.notify_one();
+
+	// stopped from one of its own tasks, the worker finishes the queue and exits on its own, and is joined by the
+	// destructor: detaching it here would leave it running on a destroyed scheduler
+	if (worker.joinable() && worker.get_id() != std::this_thread::get_id())
+	{
+		worker.join();
+	}
 }
 
 void SingleThreadSchedulerBase::flush()
 {
 	RD_ASSERT_MSG(!is_active(), "Can't flush this scheduler in a reentrant way: we are inside queued item's execution");
 
-	while (tasks_executing != 0)
-	{
-		std::this_thread::yield();
-	}
+	std::unique_lock<decltype(queue_lock)> guard(queue_lock);
+	flush_cv.wait(guard, [this]() -> bool { return tasks_executing == 0; });
 }
 
 void SingleThreadSchedulerBase::queue(std::function<void()> action)
 {
-	++tasks_executing;
-	PoolTask task(action, this);
-	pool->push(std::move(task));
+	queue_task(std::move(action));
+}
+
+void SingleThreadSchedulerBase::queue_task(util::small_task task)
+{
+	{
+		std::lock_guard<decltype(queue_lock)> guard(queue_lock);
+		if (stopping)
+		{
+			log->warn("Task is queued to the stopped scheduler {}", name);
+			return;
+		}
+
+		TaskNode* node = free_nodes;
+		if (node != nullptr)
+		{
+			free_nodes = node->next;
+			node->next = nullptr;
+		}
+		else
+		{
+			node = new TaskNode();
+		}
+		node->task = std::move(task);
+
+		if (tail == nullptr)
+		{
+			head = tail = node;
+			batch_queued_at = std::chrono::steady_clock::now();
+		}
+		else
+		{
+			tail->next = node;
+			tail = node;
+		}
+		++tasks_executing;
+	}
+	queue_cv.notify_one();
 }
 
 bool SingleThreadSchedulerBase::is_active() const
@@ -57,5 +169,45 @@ bool SingleThreadSchedulerBase::is_active() const
 	return thread_id == std::this_thread::get_id();
 }
 
-SingleThreadSchedulerBase::~SingleThreadSchedulerBase() = default;
-}	 // namespace rd
\ No newline at end of file
+SingleThreadSchedulerBase::Stats SingleThreadSchedulerBase::get_stats() const
+{
+	std::lock_guard<decltype(stats_lock)> guard(stats_lock);
+	Stats result = stats;
+	result.elapsed = std::chrono::steady_clock::now() - started_at;
+	return result;
+}
+
+std::string to_string(SingleThreadSchedulerBase::Stats const& stats)
+{
+	using us = std::chrono::duration<double, std::micro>;
+
+	const double average_latency = stats.batches == 0 ? 0.0 : us(stats.total_latency).count() / stats.batches;
+	const double busy_seconds = std::chrono::duration<double>(stats.busy_time).count();
+	return fmt::format("{} tasks in {} batches (max {}), queue latency avg {:.1f} us max {:.1f} us, {:.0f} tasks/s while busy, "
+					   "busy {:.1f} of {:.1f} s",
+		stats.tasks, stats.batches, stats.max_batch, average_latency, us(stats.max_latency).count(),
+		busy_seconds > 0 ? stats.tasks / busy_seconds : 0.0, busy_seconds, std::chrono::duration<double>(stats.elapsed).count());
+}
+
+SingleThreadSchedulerBase::~SingleThreadSchedulerBase()
+{
+	stop();
+
+	if (worker.joinable())
+	{
+		// destroyed from one of its own tasks, nothing can join the worker anymore
+		log->error("Scheduler {} is destroyed on its own thread", name);
+		worker.detach();
+	}
+
+	for (TaskNode* list : {head, free_nodes})
+	{
+		while (list != nullptr)
+		{
+			TaskNode* next = list->next;
+			delete list;
+			list = next;
+		}
+	}
+}
+}	 // namespace rd
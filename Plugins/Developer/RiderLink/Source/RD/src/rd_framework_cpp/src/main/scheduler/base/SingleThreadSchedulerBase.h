@@ -10,38 +10,85 @@
 #include "lifetime/Lifetime.h"
 #include "spdlog/spdlog.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <rd_framework_export.h>
 
-namespace ctpl
-{
-class thread_pool;
-}
-
 namespace rd
 {
 class RD_FRAMEWORK_API SingleThreadSchedulerBase : public IScheduler
 {
+public:
+	using duration_t = std::chrono::nanoseconds;
+
+	/**
+	 * \brief Counters since the scheduler started. Latency is how long the first task of a batch waited for the
+	 * batch to start, which takes a clock read per batch rather than two per task. Busy time is spent executing tasks,
+	 * so [tasks] / [busy_time] is the throughput while there is work.
+	 */
+	struct Stats
+	{
+		uint64_t tasks = 0;
+		uint64_t batches = 0;
+		size_t max_batch = 0;
+		duration_t total_latency{0};
+		duration_t max_latency{0};
+		duration_t busy_time{0};
+		duration_t elapsed{0};
+	};
+
 protected:
 	std::shared_ptr<spdlog::logger> log;
 	std::string name;
 
 	std::atomic_uint32_t tasks_executing{0};
 	std::atomic_uint32_t active{0};
-	std::unique_ptr<ctpl::thread_pool> pool;
 
-	class PoolTask
+	/**
+	 * \brief Queued tasks are linked through their nodes, and executed nodes are kept for the next tasks, so queueing
+	 * doesn't allocate once the scheduler has seen its usual backlog.
+	 */
+	struct TaskNode
 	{
-		std::function<void()> f;
-		SingleThreadSchedulerBase* scheduler;
-
-	public:
-		explicit PoolTask(std::function<void()> f, SingleThreadSchedulerBase* scheduler);
-
-		void operator()(int id) const;
+		util::small_task task;
+		TaskNode* next = nullptr;
 	};
 
+	/**
+	 * \brief The worker takes everything queued in one go and runs it without the lock, [flush] waits on [flush_cv]
+	 * until the worker has run all of it.
+	 */
+	std::mutex queue_lock;
+	std::condition_variable queue_cv;
+	std::condition_variable flush_cv;
+	TaskNode* head = nullptr;
+	TaskNode* tail = nullptr;
+	TaskNode* free_nodes = nullptr;
+	bool stopping = false;
+	// when the first task of the pending batch was queued
+	std::chrono::steady_clock::time_point batch_queued_at;
+
+	std::thread worker;
+
+	const std::chrono::steady_clock::time_point started_at = std::chrono::steady_clock::now();
+	mutable std::mutex stats_lock;
+	Stats stats;
+
+	void run();
+
+	// runs a batch taken from the queue, returns its last node
+	TaskNode* run_batch(TaskNode* batch, std::chrono::steady_clock::time_point queued_at, size_t& count);
+
+	/**
+	 * \brief Executes the tasks queued so far, then stops the worker thread. Tasks queued afterwards are dropped.
+	 * Called from the worker thread itself, it returns without waiting and the destructor joins the worker.
+	 */
+	void stop();
+
 public:
 	// region ctor/dtor
 	SingleThreadSchedulerBase(std::string name);
@@ -53,8 +100,14 @@ public:
 
 	void queue(std::function<void()> action) override;
 
+	void queue_task(util::small_task task) override;
+
 	bool is_active() const override;
+
+	Stats get_stats() const;
 };
+
+std::string RD_FRAMEWORK_API to_string(SingleThreadSchedulerBase::Stats const& stats);
 }	 // namespace rd
 #if defined(_MSC_VER)
 #pragma warning(pop)
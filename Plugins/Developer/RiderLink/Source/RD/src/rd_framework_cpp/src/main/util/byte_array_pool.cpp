@@ -0,0 +1,176 @@
+#include "byte_array_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+
+namespace rd
+{
+namespace util
+{
+constexpr size_t byte_array_pool::MIN_CLASS_SIZE;
+constexpr size_t byte_array_pool::MAX_CLASS_SIZE;
+constexpr size_t byte_array_pool::THREAD_CACHE_SIZE;
+constexpr size_t byte_array_pool::SHARED_CLASS_BYTES;
+
+namespace
+{
+using byte_array = byte_array_pool::byte_array;
+
+constexpr size_t MIN_CLASS_SHIFT = 8;
+constexpr size_t MAX_CLASS_SHIFT = 20;
+constexpr size_t CLASS_COUNT = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+static_assert(byte_array_pool::MIN_CLASS_SIZE == size_t(1) << MIN_CLASS_SHIFT, "size classes don't match");
+static_assert(byte_array_pool::MAX_CLASS_SIZE == size_t(1) << MAX_CLASS_SHIFT, "size classes don't match");
+
+size_t class_size(size_t index)
+{
+	return size_t(1) << (index + MIN_CLASS_SHIFT);
+}
+
+// smallest class that holds [size] bytes
+size_t class_to_acquire(size_t size)
+{
+	size_t index = 0;
+	while (class_size(index) < size)
+	{
+		++index;
+	}
+	return index;
+}
+
+// largest class that [capacity] bytes hold, CLASS_COUNT if the array isn't kept
+size_t class_to_release(size_t capacity)
+{
+	if (capacity < byte_array_pool::MIN_CLASS_SIZE || capacity >= 2 * byte_array_pool::MAX_CLASS_SIZE)
+	{
+		return CLASS_COUNT;
+	}
+	size_t index = 0;
+	while (class_size(index + 1) <= capacity)
+	{
+		++index;
+	}
+	return index;
+}
+
+class shared_lists
+{
+	std::mutex lock;
+	std::array<std::vector<byte_array>, CLASS_COUNT> lists;
+
+	static size_t max_count(size_t index)
+	{
+		return (std::max)(byte_array_pool::SHARED_CLASS_BYTES / class_size(index), byte_array_pool::THREAD_CACHE_SIZE);
+	}
+
+public:
+	shared_lists()
+	{
+		for (size_t i = 0; i < CLASS_COUNT; ++i)
+		{
+			lists[i].reserve(max_count(i));
+		}
+	}
+
+	// arrays above the class's limit are freed
+	void put(size_t index, std::vector<byte_array>& from, size_t count)
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		auto& list = lists[index];
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (list.size() < max_count(index))
+			{
+				list.push_back(std::move(from.back()));
+			}
+			from.pop_back();
+		}
+	}
+
+	void take(size_t index, std::vector<byte_array>& to, size_t count)
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		auto& list = lists[index];
+		for (size_t i = 0; i < count && !list.empty(); ++i)
+		{
+			to.push_back(std::move(list.back()));
+			list.pop_back();
+		}
+	}
+};
+
+// never destroyed, threads return their caches to it on exit, possibly after static destructors ran
+shared_lists& get_shared_lists()
+{
+	static shared_lists* instance = new shared_lists();
+	return *instance;
+}
+
+struct thread_cache
+{
+	std::array<std::vector<byte_array>, CLASS_COUNT> lists;
+
+	thread_cache()
+	{
+		for (auto& list : lists)
+		{
+			list.reserve(byte_array_pool::THREAD_CACHE_SIZE);
+		}
+	}
+
+	~thread_cache()
+	{
+		for (size_t i = 0; i < CLASS_COUNT; ++i)
+		{
+			get_shared_lists().put(i, lists[i], lists[i].size());
+		}
+	}
+};
+
+thread_local thread_cache cache;
+}	 // namespace
+
+byte_array_pool::byte_array byte_array_pool::acquire(size_t min_size)
+{
+	if (min_size > MAX_CLASS_SIZE)
+	{
+		return byte_array(min_size);
+	}
+
+	const size_t index = class_to_acquire(min_size);
+	auto& list = cache.lists[index];
+	if (list.empty())
+	{
+		get_shared_lists().take(index, list, THREAD_CACHE_SIZE / 2);
+	}
+	if (list.empty())
+	{
+		return byte_array(class_size(index));
+	}
+
+	byte_array result = std::move(list.back());
+	list.pop_back();
+	// within the capacity, only the bytes past the previous size are initialized
+	result.resize(class_size(index));
+	return result;
+}
+
+void byte_array_pool::release(byte_array&& array)
+{
+	const size_t index = class_to_release(array.capacity());
+	if (index == CLASS_COUNT)
+	{
+		byte_array().swap(array);
+		return;
+	}
+
+	auto& list = cache.lists[index];
+	if (list.size() == THREAD_CACHE_SIZE)
+	{
+		get_shared_lists().put(index, list, THREAD_CACHE_SIZE / 2);
+	}
+	list.push_back(std::move(array));
+}
+}	 // namespace util
+}	 // namespace rd
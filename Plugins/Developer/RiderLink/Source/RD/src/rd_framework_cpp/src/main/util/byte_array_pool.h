@@ -0,0 +1,50 @@
+#ifndef RD_CPP_BYTE_ARRAY_POOL_H
+#define RD_CPP_BYTE_ARRAY_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Recycles the byte arrays of outgoing messages, so that serializing a message and keeping it until the
+ * counterpart acknowledges it don't hit the allocator in a steady state.
+ * Arrays are kept by size class (powers of two from [MIN_CLASS_SIZE] to [MAX_CLASS_SIZE]) in a small cache per
+ * thread, which trades half of itself with a shared list under a lock when it overflows or runs dry. That way arrays
+ * acquired by producer threads and released by the send thread flow back in batches.
+ */
+class RD_FRAMEWORK_API byte_array_pool
+{
+public:
+	using byte_array = std::vector<uint8_t>;
+
+	static constexpr size_t MIN_CLASS_SIZE = 1u << 8;
+	static constexpr size_t MAX_CLASS_SIZE = 1u << 20;
+
+	/**
+	 * \brief Arrays kept per size class by a thread, and at most [SHARED_CLASS_BYTES] of them by the shared list.
+	 */
+	static constexpr size_t THREAD_CACHE_SIZE = 16;
+	static constexpr size_t SHARED_CLASS_BYTES = 4u << 20;
+
+	/**
+	 * \return array of at least [min_size] bytes, sized to its whole size class so it can grow without reallocating.
+	 * Its content is unspecified.
+	 */
+	static byte_array acquire(size_t min_size);
+
+	/**
+	 * \brief Any array can be released, not only acquired ones. Arrays below the smallest size class or above the
+	 * largest one are freed.
+	 */
+	static void release(byte_array&& array);
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_BYTE_ARRAY_POOL_H
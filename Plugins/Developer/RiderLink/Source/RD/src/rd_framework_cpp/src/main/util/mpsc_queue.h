@@ -0,0 +1,119 @@
+#ifndef RD_CPP_MPSC_QUEUE_H
+#define RD_CPP_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace rd
+{
+namespace util
+{
+/**
+ * \brief Bounded lock-free queue for any number of producers and a single consumer.
+ * Every cell carries a sequence number telling whose turn it is (D. Vyukov's bounded queue), so producers only
+ * contend on a single compare-exchange of the enqueue position and the consumer never writes shared state but the cell.
+ * \tparam T default constructible, moved in and out of the cells
+ */
+template <typename T>
+class mpsc_queue
+{
+	struct cell
+	{
+		std::atomic<size_t> sequence{0};
+		T value{};
+	};
+
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+	std::unique_ptr<cell[]> cells;
+	const size_t mask;
+
+	// producers and the consumer write different cache lines
+	char pad0[CACHE_LINE_SIZE]{};
+	std::atomic<size_t> enqueue_pos{0};
+	char pad1[CACHE_LINE_SIZE]{};
+	size_t dequeue_pos = 0;
+
+public:
+	/**
+	 * \param capacity power of two
+	 */
+	explicit mpsc_queue(size_t capacity) : cells(new cell[capacity]), mask(capacity - 1)
+	{
+		assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+		for (size_t i = 0; i < capacity; ++i)
+		{
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	mpsc_queue(mpsc_queue const&) = delete;
+
+	mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+	/**
+	 * \brief Thread-safe. [value] is moved from only on success.
+	 * \return false if the queue is full
+	 */
+	bool try_push(T& value)
+	{
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell& c = cells[pos & mask];
+			const size_t seq = c.sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+			if (diff == 0)
+			{
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					c.value = std::move(value);
+					c.sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/**
+	 * \brief Consumer thread only.
+	 * \return false if the queue is empty or the next push hasn't finished yet
+	 */
+	bool try_pop(T& value)
+	{
+		cell& c = cells[dequeue_pos & mask];
+		if (c.sequence.load(std::memory_order_acquire) != dequeue_pos + 1)
+		{
+			return false;
+		}
+		value = std::move(c.value);
+		c.value = T{};
+		c.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+		++dequeue_pos;
+		return true;
+	}
+
+	/**
+	 * \brief Consumer thread only.
+	 */
+	bool empty() const
+	{
+		return cells[dequeue_pos & mask].sequence.load(std::memory_order_acquire) != dequeue_pos + 1;
+	}
+};
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_MPSC_QUEUE_H
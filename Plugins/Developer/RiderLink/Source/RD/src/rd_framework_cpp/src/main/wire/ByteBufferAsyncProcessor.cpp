@@ -1,22 +1,24 @@
 #include "ByteBufferAsyncProcessor.h"
 
 #include "util/guards.h"
+#include "util/byte_array_pool.h"
 #include <util/thread_util.h>
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace rd
 {
-size_t ByteBufferAsyncProcessor::INITIAL_CAPACITY = 1024 * 1024;
-
 std::shared_ptr<spdlog::logger> ByteBufferAsyncProcessor::logger =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("byteBufferLog", spdlog::color_mode::automatic);
 
-ByteBufferAsyncProcessor::ByteBufferAsyncProcessor(
-	std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor)
+constexpr size_t ByteBufferAsyncProcessor::MAX_BATCH_SIZE;
+constexpr size_t ByteBufferAsyncProcessor::MAX_BATCH_PACKAGES;
+constexpr size_t ByteBufferAsyncProcessor::INCOMING_CAPACITY;
+
+ByteBufferAsyncProcessor::ByteBufferAsyncProcessor(std::string id, processor_t processor)
 	: id(std::move(id)), processor(std::move(processor))
 {
-	data.reserve(INITIAL_CAPACITY);
+	batch.reserve(MAX_BATCH_PACKAGES);
 }
 
 void ByteBufferAsyncProcessor::cleanup0()
@@ -29,6 +31,7 @@ void ByteBufferAsyncProcessor::cleanup0()
 	// TO-DO clean data
 
 	cv.notify_all();
+	notify_space();
 }
 
 bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set, string_view action)
@@ -51,6 +54,7 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 		state = state_to_set;
 	}
 	cv.notify_all();
+	notify_space();
 
 	std::future_status status = async_future.wait_for(timeout);
 
@@ -67,13 +71,101 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 	return success;
 }
 
-void ByteBufferAsyncProcessor::add_data(std::vector<Buffer::ByteArray>&& new_data)
+bool ByteBufferAsyncProcessor::drain_incoming()
 {
 	std::lock_guard<decltype(queue_lock)> guard(queue_lock);
-	std::move(new_data.begin(), new_data.end(), std::back_inserter(queue));
-	//		for (auto &&item : new_data) {
-	//			queue.emplace(std::move(item));
-	//		}
+
+	bool drained = false;
+	Buffer::ByteArray item;
+	while (incoming.try_pop(item))
+	{
+		queue.push_back(std::move(item));
+		drained = true;
+	}
+	return drained;
+}
+
+void ByteBufferAsyncProcessor::wake_worker()
+{
+	// pairs with the fence in ThreadProc: either the worker sees the new item or this sees it waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (worker_waiting.load(std::memory_order_relaxed))
+	{
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			worker_waiting.store(false, std::memory_order_relaxed);
+		}
+		cv.notify_all();
+	}
+}
+
+size_t ByteBufferAsyncProcessor::process_batch(std::deque<Buffer::ByteArray> const& source, size_t from, sequence_number_t seqn)
+{
+	batch.clear();
+
+	size_t batch_size = 0;
+	for (size_t i = from; i < source.size() && batch.size() < MAX_BATCH_PACKAGES; ++i)
+	{
+		batch_size += source[i].size();
+		// a package larger than the limit still goes alone
+		if (!batch.empty() && batch_size > MAX_BATCH_SIZE)
+		{
+			break;
+		}
+		batch.push_back(&source[i]);
+	}
+
+	return processor(batch.data(), batch.size(), seqn);
+}
+
+size_t ByteBufferAsyncProcessor::held_bytes() const
+{
+	return queued_bytes.load(std::memory_order_relaxed) + unacked_bytes.load(std::memory_order_relaxed);
+}
+
+void ByteBufferAsyncProcessor::wait_for_space()
+{
+	if (interrupt_balance != 0)
+	{
+		return;
+	}
+
+	++blocked_puts;
+
+	std::unique_lock<decltype(space_lock)> guard(space_lock);
+	const bool has_space = space_cv.wait_for(guard, max_block_time, [this]() -> bool {
+		return held_bytes() <= low_watermark || state >= StateKind::Stopping || interrupt_balance != 0;
+	});
+	if (!has_space)
+	{
+		logger->warn("{}: still holds {} bytes after waiting {} for acknowledgements", id, held_bytes(), to_string(max_block_time));
+	}
+}
+
+void ByteBufferAsyncProcessor::notify_space()
+{
+	{
+		std::lock_guard<decltype(space_lock)> guard(space_lock);
+	}
+	space_cv.notify_all();
+}
+
+void ByteBufferAsyncProcessor::drop_acknowledged()
+{
+	const size_t held_before = held_bytes();
+
+	while (current_seqn <= acknowledged_seqn && !pending_queue.empty())
+	{
+		unacked_bytes -= pending_queue.front().size();
+		util::byte_array_pool::release(std::move(pending_queue.front()));
+		pending_queue.pop_front();
+		++current_seqn;
+	}
+
+	if (held_before > low_watermark && held_bytes() <= low_watermark)
+	{
+		notify_space();
+	}
 }
 
 bool ByteBufferAsyncProcessor::reprocess()
@@ -88,18 +180,16 @@ bool ByteBufferAsyncProcessor::reprocess()
 
 		logger->debug("{}: reprocessing waited for main processing", id);
 
-		while (current_seqn <= acknowledged_seqn)
+		std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+		drop_acknowledged();
+		for (size_t i = 0; i < pending_queue.size();)
 		{
-			pending_queue.pop_front();
-			++current_seqn;
-		}
-		for (int i = 0; i < pending_queue.size(); ++i)
-		{
-			auto const& item = pending_queue[i];
-			if (!processor(item, current_seqn + i))
+			const size_t sent = process_batch(pending_queue, i, current_seqn + i);
+			if (sent < batch.size())
 			{
 				return false;
 			}
+			i += sent;
 		}
 	}
 	return true;
@@ -114,11 +204,24 @@ void ByteBufferAsyncProcessor::process()
 
 		logger->debug("{}: processing started", id);
 
-		while (!queue.empty() && processor(queue.front(), max_sent_seqn + 1))
+		while (!queue.empty())
 		{
-			++max_sent_seqn;
-			pending_queue.push_back(std::move(queue.front()));
-			queue.pop_front();
+			const size_t sent = process_batch(queue, 0, max_sent_seqn + 1);
+			std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+			for (size_t i = 0; i < sent; ++i)
+			{
+				++max_sent_seqn;
+				queued_bytes -= queue.front().size();
+				unacked_bytes += queue.front().size();
+				pending_queue.push_back(std::move(queue.front()));
+				queue.pop_front();
+			}
+			// acknowledgements may have arrived before these were moved here
+			drop_acknowledged();
+			if (sent < batch.size())
+			{
+				break;
+			}
 		}
 	}
 	processing_cv.notify_all();
@@ -134,30 +237,40 @@ void ByteBufferAsyncProcessor::ThreadProc()
 	while (true)
 	{
 		{
-			std::lock_guard<decltype(lock)> guard(lock);
+			std::unique_lock<decltype(lock)> guard(lock);
 
 			if (state >= StateKind::Terminated)
 			{
 				return;
 			}
 
-			while (data.empty() || interrupt_balance != 0)
+			has_new_data |= drain_incoming();
+			while (!has_new_data || interrupt_balance != 0)
 			{
 				if (state >= StateKind::Stopping)
 				{
 					return;
 				}
-				cv.wait(lock);
 
-				logger->debug("{}'s ThreadProc waited for notify", id);
+				worker_waiting.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (incoming.empty())
+				{
+					cv.wait(guard);
+
+					logger->debug("{}'s ThreadProc waited for notify", id);
+				}
+				worker_waiting.store(false, std::memory_order_relaxed);
 
 				if (state >= StateKind::Terminating)
 				{
 					return;
 				}
+
+				// drained while paused too, so producers never wait for a reconnect
+				has_new_data |= drain_incoming();
 			}
-			add_data(std::move(data));
-			data.clear();
+			has_new_data = false;
 		}
 
 		try
@@ -198,18 +311,56 @@ bool ByteBufferAsyncProcessor::terminate(time_t timeout)
 	return terminate0(timeout, StateKind::Terminating, "TERMINATE");
 }
 
-void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
+void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data, bool droppable)
 {
+	if (state >= StateKind::Stopping)
 	{
-		std::lock_guard<decltype(lock)> guard(lock);
+		util::byte_array_pool::release(std::move(new_data));
+		return;
+	}
 
-		if (state >= StateKind::Stopping)
+	if (held_bytes() >= high_watermark)
+	{
+		if (droppable)
 		{
+			++dropped_packages;
+			dropped_bytes += new_data.size();
+			util::byte_array_pool::release(std::move(new_data));
 			return;
 		}
-		data.emplace_back(std::move(new_data));
+		wait_for_space();
 	}
-	cv.notify_all();
+
+	queued_bytes += new_data.size();
+
+	while (!incoming.try_push(new_data))
+	{
+		// the worker keeps draining, so the queue is only full for the moment it takes to wake up
+		wake_worker();
+		std::this_thread::yield();
+	}
+	wake_worker();
+}
+
+void ByteBufferAsyncProcessor::set_watermarks(size_t low, size_t high, time_t block_time)
+{
+	RD_ASSERT_MSG(low <= high, "low watermark must not exceed the high one")
+
+	std::lock_guard<decltype(space_lock)> guard(space_lock);
+	low_watermark = low;
+	high_watermark = high;
+	max_block_time = block_time;
+}
+
+ByteBufferAsyncProcessor::Metrics ByteBufferAsyncProcessor::get_metrics() const
+{
+	Metrics metrics;
+	metrics.queued_bytes = queued_bytes;
+	metrics.unacked_bytes = unacked_bytes;
+	metrics.dropped_packages = dropped_packages;
+	metrics.dropped_bytes = dropped_bytes;
+	metrics.blocked_puts = blocked_puts;
+	return metrics;
 }
 
 void ByteBufferAsyncProcessor::pause(const std::string& reason)
@@ -217,6 +368,8 @@ void ByteBufferAsyncProcessor::pause(const std::string& reason)
 	std::lock_guard<decltype(lock)> guard(lock);
 
 	++interrupt_balance;
+	// producers waiting for acknowledgements won't get them before the reconnect
+	notify_space();
 
 	logger->debug("{} paused with reason={},state={}", id, reason, to_string(state));
 
@@ -253,6 +406,9 @@ void ByteBufferAsyncProcessor::acknowledge(sequence_number_t seqn)
 	{
 		logger->trace("{}: new acknowledged seqn: {}", this->id, seqn);
 		acknowledged_seqn = seqn;
+
+		std::lock_guard<decltype(pending_lock)> pending_guard(pending_lock);
+		drop_acknowledged();
 	}
 	else
 	{
@@ -7,8 +7,10 @@
 #endif
 
 #include "protocol/Buffer.h"
+#include "util/mpsc_queue.h"
 #include "spdlog/spdlog.h"
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <mutex>
@@ -34,34 +36,87 @@ public:
 		Terminated
 	};
 
+	/**
+	 * \brief Sends [count] consecutive packages, the first one with sequence number [seqn].
+	 * \return number of packages that were sent completely, less than [count] means the connection failed
+	 */
+	using processor_t = std::function<size_t(Buffer::ByteArray const* const* packages, size_t count, sequence_number_t seqn)>;
+
+	/**
+	 * \brief Limits of a single call to the processor, everything queued at wake-up is drained in batches of this size.
+	 */
+	static constexpr size_t MAX_BATCH_SIZE = 1u << 16;
+	static constexpr size_t MAX_BATCH_PACKAGES = 256;
+
+	/**
+	 * \brief Bytes held by the processor: queued are not sent yet, unacked are sent and kept for a resend until the
+	 * counterpart acknowledges them. Droppable packages put above the high watermark are dropped.
+	 */
+	struct Metrics
+	{
+		size_t queued_bytes = 0;
+		size_t unacked_bytes = 0;
+		uint64_t dropped_packages = 0;
+		uint64_t dropped_bytes = 0;
+		uint64_t blocked_puts = 0;
+	};
+
 private:
 	using time_t = std::chrono::milliseconds;
 
-	static size_t INITIAL_CAPACITY;
+	/**
+	 * \brief Capacity of the hand-off from producers, the worker drains it into [queue] even while paused.
+	 */
+	static constexpr size_t INCOMING_CAPACITY = 4096;
 
 	std::recursive_mutex lock;
 	std::condition_variable_any cv;
 
 	std::string id;
 
-	std::function<bool(Buffer::ByteArray const&, sequence_number_t seqn)> processor;
+	processor_t processor;
 
-	StateKind state{StateKind::Initialized};
+	std::atomic<StateKind> state{StateKind::Initialized};
 	static std::shared_ptr<spdlog::logger> logger;
 
 	std::thread::id async_thread_id;
 	std::future<void> async_future;
 
-	std::vector<Buffer::ByteArray> data;
+	util::mpsc_queue<Buffer::ByteArray> incoming{INCOMING_CAPACITY};
+	// set while the worker waits on [cv], producers only take [lock] to wake it then
+	std::atomic<bool> worker_waiting{false};
+	// drained from [incoming] but not processed yet
+	bool has_new_data = false;
+
 	std::mutex queue_lock;
 	std::deque<Buffer::ByteArray> queue{};
-	std::deque<Buffer::ByteArray> pending_queue{};
-
+	std::vector<Buffer::ByteArray const*> batch;
 	sequence_number_t max_sent_seqn = 0;
-	sequence_number_t current_seqn = 1;
-	sequence_number_t acknowledged_seqn = 0;
 
-	int32_t interrupt_balance = 0;
+	// sent packages kept until acknowledged, separate from [queue_lock] so acknowledgements apply while sending
+	std::mutex pending_lock;
+	std::deque<Buffer::ByteArray> pending_queue{};
+	sequence_number_t current_seqn = 1;
+	std::atomic<sequence_number_t> acknowledged_seqn{0};
+
+	/**
+	 * \brief Above [high_watermark] bytes a put either drops a droppable package or waits up to [max_block_time]
+	 * for acknowledgements to bring the total under [low_watermark]. It doesn't wait while paused, every package
+	 * that isn't droppable has to reach the counterpart after the reconnect.
+	 */
+	std::atomic<size_t> low_watermark{32u << 20};
+	std::atomic<size_t> high_watermark{64u << 20};
+	time_t max_block_time{1000};
+
+	std::atomic<size_t> queued_bytes{0};
+	std::atomic<size_t> unacked_bytes{0};
+	std::atomic<uint64_t> dropped_packages{0};
+	std::atomic<uint64_t> dropped_bytes{0};
+	std::atomic<uint64_t> blocked_puts{0};
+	std::mutex space_lock;
+	std::condition_variable space_cv;
+
+	std::atomic<int32_t> interrupt_balance{0};
 	bool in_processing = false;
 	std::mutex processing_lock;
 	std::condition_variable processing_cv;
@@ -69,7 +124,7 @@ private:
 public:
 	// region ctor/dtor
 
-	explicit ByteBufferAsyncProcessor(std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor);
+	explicit ByteBufferAsyncProcessor(std::string id, processor_t processor);
 
 	// endregion
 private:
@@ -77,7 +132,20 @@ private:
 
 	bool terminate0(time_t timeout, StateKind state_to_set, string_view action);
 
-	void add_data(std::vector<Buffer::ByteArray>&& new_data);
+	bool drain_incoming();
+
+	void wake_worker();
+
+	size_t process_batch(std::deque<Buffer::ByteArray> const& source, size_t from, sequence_number_t seqn);
+
+	size_t held_bytes() const;
+
+	void wait_for_space();
+
+	void notify_space();
+
+	// expects pending_lock to be held
+	void drop_acknowledged();
 
 	bool reprocess();
 
@@ -92,7 +160,14 @@ public:
 
 	bool terminate(time_t timeout = time_t(0) /*InfiniteDuration*/);
 
-	void put(Buffer::ByteArray new_data);
+	/**
+	 * \param droppable the package may be dropped instead of waiting when the processor holds too many bytes
+	 */
+	void put(Buffer::ByteArray new_data, bool droppable = false);
+
+	void set_watermarks(size_t low, size_t high, time_t block_time);
+
+	Metrics get_metrics() const;
 
 	void pause(const std::string& reason);
 
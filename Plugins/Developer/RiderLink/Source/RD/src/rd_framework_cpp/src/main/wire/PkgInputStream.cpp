@@ -6,51 +6,30 @@
 
 namespace rd
 {
-void PkgInputStream::rewind()
-{
-	buffer.rewind();
-}
-
-void PkgInputStream::require_available(int size)
-{
-	buffer.require_available(size);
-}
-
-size_t PkgInputStream::get_position() const
-{
-	return buffer.get_position();
-}
-
-Buffer::word_t* PkgInputStream::data()
-{
-	return buffer.data();
-}
-
-Buffer& PkgInputStream::get_buffer()
-{
-	return buffer;
-}
-
 int32_t PkgInputStream::try_read(Buffer::word_t* res, size_t size)
 {
-	if (memory == -1 || buffer.get_position() == memory)
+	if (remaining == 0)
 	{
-		memory = request_data();
-		if (memory == -1)
+		const int32_t len = request_data();
+		if (len == -1)
 		{
 			return -1;
 		}
+		remaining = static_cast<size_t>(len);
+	}
+	const size_t n = (std::min)(size, remaining);
+	if (!read_data(res, n))
+	{
+		remaining = 0;
+		return -1;
 	}
-	const int32_t n = static_cast<int32_t>((std::min)(size, memory - buffer.get_position()));
-	Buffer::word_t* start = buffer.current_pointer();
-	std::copy(start, start + n, res);
-	buffer.set_position(buffer.get_position() + n);
-	return n;
+	remaining -= n;
+	return static_cast<int32_t>(n);
 }
 
 bool PkgInputStream::read(Buffer::word_t* res, size_t size)
 {
-	//		spdlog::trace("PkgInputStream call: size={}, pos={}, memory={}", size, buffer.get_position(), memory);
+	//		spdlog::trace("PkgInputStream call: size={}, remaining={}", size, remaining);
 
 	int32_t summary_size = 0;
 	while (summary_size < size)
@@ -12,31 +12,27 @@
 
 namespace rd
 {
+/**
+ * \brief Reads the payloads of consecutive packages as one stream. The bytes go straight from the source to the
+ * caller, a package isn't buffered on its own.
+ */
 class RD_FRAMEWORK_API PkgInputStream
 {
 private:
-	Buffer buffer;
-
+	// starts the next package, returns its length or -1
 	std::function<int32_t()> request_data;
 
-	size_t memory = 0;
+	// reads bytes of the current package
+	std::function<bool(Buffer::word_t*, size_t)> read_data;
+
+	size_t remaining = 0;
 
 public:
-	template <typename F>
-	explicit PkgInputStream(F&& f) : request_data(std::forward<F>(f))
+	template <typename F, typename G>
+	PkgInputStream(F&& f, G&& g) : request_data(std::forward<F>(f)), read_data(std::forward<G>(g))
 	{
 	}
 
-	void rewind();
-
-	void require_available(int size);
-
-	size_t get_position() const;
-
-	Buffer::word_t* data();
-
-	Buffer& get_buffer();
-
 	int32_t try_read(Buffer::word_t* res, size_t size);
 
 	bool read(Buffer::word_t* res, size_t size);
@@ -11,6 +11,7 @@
 #include <utility>
 #include <thread>
 #include <csignal>
+#include <cstring>
 
 namespace rd
 {
@@ -22,6 +23,8 @@ std::chrono::milliseconds SocketWire::timeout = std::chrono::milliseconds(500);
 constexpr int32_t SocketWire::Base::ACK_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PING_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PACKAGE_HEADER_LENGTH;
+constexpr int32_t SocketWire::Base::ACK_PACKAGES_THRESHOLD;
+constexpr int32_t SocketWire::Base::ACK_DELAY_MS;
 
 SocketWire::Base::Base(std::string id, Lifetime parentLifetime, IScheduler* scheduler)
 	: WireBase(scheduler), id(std::move(id)), scheduler(scheduler), lifetimeDef(parentLifetime)
@@ -68,46 +71,120 @@ void SocketWire::Base::receiverProc() const
 	}
 }
 
-bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seqn) const
+namespace
 {
-	try
+// a header and a body per package, and a piggybacked ack
+constexpr size_t MAX_SEND_VECTOR = 2 * ByteBufferAsyncProcessor::MAX_BATCH_PACKAGES + 1;
+
+void write_header(Buffer::word_t* header, int32_t len, sequence_number_t seqn)
+{
+	std::memcpy(header, &len, sizeof(len));
+	std::memcpy(header + sizeof(len), &seqn, sizeof(seqn));
+}
+
+// clsocket falls back to one send per buffer on Windows, so WSASend is called directly there
+int64_t send_vector(CSimpleSocket* socket, iovec* vector, size_t count)
+{
+#ifdef _WIN32
+	WSABUF buffers[MAX_SEND_VECTOR];
+	for (size_t i = 0; i < count; ++i)
 	{
-		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+		buffers[i].buf = static_cast<char*>(vector[i].iov_base);
+		buffers[i].len = static_cast<ULONG>(vector[i].iov_len);
+	}
+	DWORD sent = 0;
+	if (WSASend(socket->GetSocketDescriptor(), buffers, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+	{
+		return -1;
+	}
+	return sent;
+#else
+	return socket->Send(vector, static_cast<int32_t>(count));
+#endif
+}
+}	 // namespace
 
-		int32_t msglen = static_cast<int32_t>(msg.size());
+size_t SocketWire::Base::send0(Buffer::ByteArray const* const* packages, size_t count, sequence_number_t seqn) const
+{
+	RD_ASSERT_MSG(count <= ByteBufferAsyncProcessor::MAX_BATCH_PACKAGES, "too many packages in one batch")
 
-		send_package_header.rewind();
-		send_package_header.write_integral(msglen);
-		send_package_header.write_integral(seqn);
+	Buffer::word_t headers[(ByteBufferAsyncProcessor::MAX_BATCH_PACKAGES + 1) * PACKAGE_HEADER_LENGTH];
+	iovec parts[MAX_SEND_VECTOR];
 
-		RD_ASSERT_THROW_MSG(
-			socket_provider->Send(send_package_header.data(), send_package_header.get_position()) == PACKAGE_HEADER_LENGTH,
-			this->id +
-				": failed to send header over the network"
-				", reason: " +
-				socket_provider->DescribeError())
+	// parts[0] is left for the ack
+	size_t total = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		Buffer::word_t* header = headers + (i + 1) * PACKAGE_HEADER_LENGTH;
+		const int32_t msglen = static_cast<int32_t>(packages[i]->size());
+		write_header(header, msglen, seqn + static_cast<sequence_number_t>(i));
 
-		RD_ASSERT_THROW_MSG(socket_provider->Send(msg.data(), msglen) == msglen, this->id +
-																					 ": failed to send package over the network"
-																					 ", reason: " +
-																					 socket_provider->DescribeError());
-		logger->info("{}: were sent {} bytes", this->id, msglen);
-		//        RD_ASSERT_MSG(socketProvider->Flush(), "{}: failed to flush");
-		return true;
+		parts[2 * i + 1] = {header, PACKAGE_HEADER_LENGTH};
+		parts[2 * i + 2] = {const_cast<Buffer::word_t*>(packages[i]->data()), packages[i]->size()};
+		total += PACKAGE_HEADER_LENGTH + msglen;
 	}
-	catch (std::exception const& e)
+
+	size_t sent_total = 0;
+	size_t ack_length = 0;
 	{
-		//			async_send_buffer.pause("send0");
-		logger->warn("Send0 failed due to: | {}", e.what());
-		return false;
+		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+
+		iovec* it = parts + 1;
+		iovec* const end = parts + 2 * count + 1;
+
+		const sequence_number_t ack_seqn = pending_ack_seqn.exchange(0);
+		if (ack_seqn != 0)
+		{
+			write_header(headers, ACK_MESSAGE_LENGTH, ack_seqn);
+			parts[0] = {headers, PACKAGE_HEADER_LENGTH};
+			ack_length = PACKAGE_HEADER_LENGTH;
+			--it;
+		}
+		while (it != end)
+		{
+			const int64_t sent = send_vector(socket_provider.get(), it, end - it);
+			if (sent <= 0)
+			{
+				logger->warn("{}: failed to send {} packages over the network, sent {} of {} bytes, reason: {}", this->id, count,
+					sent_total, total, socket_provider->DescribeError());
+				break;
+			}
+			sent_total += sent;
+
+			// skip what was written, a short write leaves the rest of a buffer for the next call
+			size_t rest = static_cast<size_t>(sent);
+			while (it != end && rest >= it->iov_len)
+			{
+				rest -= it->iov_len;
+				++it;
+			}
+			if (rest > 0)
+			{
+				it->iov_base = static_cast<Buffer::word_t*>(it->iov_base) + rest;
+				it->iov_len -= rest;
+			}
+		}
+	}
+
+	size_t sent_packages = 0;
+	for (size_t written = ack_length; sent_packages < count; ++sent_packages)
+	{
+		written += PACKAGE_HEADER_LENGTH + packages[sent_packages]->size();
+		if (written > sent_total)
+		{
+			break;
+		}
 	}
+
+	logger->info("{}: were sent {} bytes in {} packages", this->id, sent_total, sent_packages);
+	return sent_packages;
 }
 
 void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const
 {
 	RD_ASSERT_MSG(!rd_id.isNull(), "{}: id mustn't be null");
 
-	Buffer local_send_buffer;
+	Buffer local_send_buffer = Buffer::from_pool();
 	local_send_buffer.write_integral<int32_t>(0);	 // placeholder for length
 	rd_id.write(local_send_buffer);					 // write id
 	local_send_buffer.write_integral<int16_t>(0);	 // placeholder for context
@@ -118,7 +195,40 @@ void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer
 	local_send_buffer.rewind();
 	local_send_buffer.write_integral<int32_t>(len - 4);
 	local_send_buffer.set_position(len);
-	async_send_buffer.put(std::move(local_send_buffer).getRealArray());
+	async_send_buffer.put(std::move(local_send_buffer).getRealArray(), is_droppable(rd_id));
+}
+
+bool SocketWire::Base::is_droppable(RdId const& rd_id) const
+{
+	droppable_set_t const* ids = droppable_ids.load(std::memory_order_acquire);
+	return ids != nullptr && ids->count(rd_id.get_hash()) != 0;
+}
+
+void SocketWire::Base::set_droppable(RdId const& rd_id, bool droppable)
+{
+	std::lock_guard<decltype(droppable_lock)> guard(droppable_lock);
+	droppable_set_t const* current = droppable_ids.load(std::memory_order_relaxed);
+	auto ids = current != nullptr ? std::make_unique<droppable_set_t>(*current) : std::make_unique<droppable_set_t>();
+	if (droppable)
+	{
+		ids->insert(rd_id.get_hash());
+	}
+	else
+	{
+		ids->erase(rd_id.get_hash());
+	}
+	droppable_ids.store(ids->empty() ? nullptr : ids.get(), std::memory_order_release);
+	droppable_sets.push_back(std::move(ids));
+}
+
+void SocketWire::Base::set_send_watermarks(size_t low, size_t high, std::chrono::milliseconds block_time)
+{
+	async_send_buffer.set_watermarks(low, high, block_time);
+}
+
+ByteBufferAsyncProcessor::Metrics SocketWire::Base::get_send_metrics() const
+{
+	return async_send_buffer.get_metrics();
 }
 
 void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_socket)
@@ -126,6 +236,8 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 	{
 		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
 		socket_provider = std::move(new_socket);
+		// acks of the previous connection mean nothing to the new one
+		pending_ack_seqn.store(0);
 		socket_send_var.notify_all();
 	}
 	{
@@ -195,16 +307,19 @@ bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) con
 		if (available > 0)
 		{
 			int32_t copylen = (std::min)(rest, available);
-			std::copy(lo, lo + copylen, res + ptr);
+			if (res != nullptr)
+			{
+				std::copy(lo, lo + copylen, res + ptr);
+			}
 			lo += copylen;
 			ptr += copylen;
 		}
 		else
 		{
-			if (hi == receiver_buffer.end())
-			{
-				hi = lo = receiver_buffer.begin();
-			}
+			// everything received is consumed, the whole buffer is free for the next receive
+			hi = lo = receiver_buffer.begin();
+			// everything that arrived is processed, acknowledge it before blocking
+			flush_ack();
 			logger->info("{}: receive started", this->id);
 			int32_t read = socket_provider->Receive(static_cast<int32_t>(receiver_buffer.end() - hi), &*hi);
 			if (read == -1)
@@ -300,34 +415,53 @@ std::pair<int, sequence_number_t> SocketWire::Base::read_header() const
 
 int32_t SocketWire::Base::read_package() const
 {
-	receive_pkg.rewind();
-
-	const auto pair = read_header();
-	if (pair == INVALID_HEADER)
+	while (true)
 	{
-		logger->debug("{}: failed to read header", this->id);
-		return -1;
-	}
-	const auto len = pair.first;
-	const auto seqn = pair.second;
+		const auto pair = read_header();
+		if (pair == INVALID_HEADER)
+		{
+			logger->debug("{}: failed to read header", this->id);
+			return -1;
+		}
+		const auto len = pair.first;
+		const auto seqn = pair.second;
+
+		logger->debug("{}: read len={}, seqn={}, max_received_seqn={}", this->id, len, seqn, max_received_seqn);
 
-	logger->debug("{}: read len={}, seqn={}, max_received_seqn={}", this->id, len, seqn, max_received_seqn);
+		if (seqn <= max_received_seqn && seqn != 1)
+		{
+			// resent after a reconnect, but already received
+			if (!read_from_socket(nullptr, len))
+			{
+				logger->debug("{}: failed to skip package", this->id);
+				return -1;
+			}
+			acknowledge_later(seqn);
+			continue;
+		}
+		max_received_seqn = seqn;
+
+		logger->info("{}: was received package, bytes={}, seqn={}", this->id, len, seqn);
+		// the payload stays in the receive buffer, receive_pkg reads it from there right into the messages
+		package_seqn = seqn;
+		package_remaining = len;
+		return len;
+	}
+}
 
-	receive_pkg.require_available(len);
-	if (!read_data_from_socket(receive_pkg.data(), len))
+bool SocketWire::Base::read_package_data(Buffer::word_t* data, size_t len) const
+{
+	if (!read_data_from_socket(data, len))
 	{
 		logger->debug("{}: failed to read package", this->id);
-		return -1;
+		return false;
 	}
-	send_ack(seqn);
-	if (seqn <= max_received_seqn && seqn != 1)
+	package_remaining -= static_cast<int32_t>(len);
+	if (package_remaining == 0)
 	{
-		return true;
+		acknowledge_later(package_seqn);
 	}
-	max_received_seqn = seqn;
-
-	logger->info("{}: was received package, bytes={}, seqn={}", this->id, len, seqn);
-	return len;
+	return true;
 }
 
 bool SocketWire::Base::read_and_dispatch_message() const
@@ -347,9 +481,10 @@ bool SocketWire::Base::read_and_dispatch_message() const
 	logger->trace("{}: message info: sz={}, id={}", this->id, sz, id_);
 	const RdId rd_id{id_};
 	sz -= 8;	// RdId
-	message.require_available(sz);
+	// handlers release it to the pool once they are done with it, whichever thread they run on
+	Buffer message = Buffer::from_pool(sz);
 
-	if (!receive_pkg.read(message.data() + message.get_position(), sz - message.get_position()))
+	if (!receive_pkg.read(message.data(), sz))
 	{
 		logger->error("{}: constructing message failed", this->id);
 		return false;
@@ -361,7 +496,6 @@ bool SocketWire::Base::read_and_dispatch_message() const
 
 	sz = -1;
 	id_ = -1;
-	message.rewind();
 	return true;
 	//		RD_ASSERT_MSG(summary_size == sz, "Broken message, read:%d bytes, expected:%d bytes", summary_size, sz)
 }
@@ -412,6 +546,12 @@ void SocketWire::Base::ping() const
 }
 
 bool SocketWire::Base::send_ack(sequence_number_t seqn) const
+{
+	std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+	return send_ack0(seqn);
+}
+
+bool SocketWire::Base::send_ack0(sequence_number_t seqn) const
 {
 	logger->trace("{} send ack {}", id, seqn);
 	try
@@ -419,14 +559,11 @@ bool SocketWire::Base::send_ack(sequence_number_t seqn) const
 		ack_buffer.rewind();
 		ack_buffer.write_integral(ACK_MESSAGE_LENGTH);
 		ack_buffer.write_integral(seqn);
-		{
-			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
-			RD_ASSERT_THROW_MSG(socket_provider->Send(ack_buffer.data(), ack_buffer.get_position()) == PACKAGE_HEADER_LENGTH,
-				this->id +
-					": failed to send ack over the network"
-					", reason: " +
-					socket_provider->DescribeError())
-		}
+		RD_ASSERT_THROW_MSG(socket_provider->Send(ack_buffer.data(), ack_buffer.get_position()) == PACKAGE_HEADER_LENGTH,
+			this->id +
+				": failed to send ack over the network"
+				", reason: " +
+				socket_provider->DescribeError())
 		return true;
 	}
 	catch (std::exception const& e)
@@ -436,6 +573,28 @@ bool SocketWire::Base::send_ack(sequence_number_t seqn) const
 	}
 }
 
+void SocketWire::Base::acknowledge_later(sequence_number_t seqn) const
+{
+	// acks are cumulative, the latest seqn covers every package before it
+	pending_ack_seqn.store(seqn);
+
+	const auto now = std::chrono::steady_clock::now();
+	if (++unacked_packages >= ACK_PACKAGES_THRESHOLD || now - last_ack_time >= std::chrono::milliseconds(ACK_DELAY_MS))
+	{
+		flush_ack();
+	}
+}
+
+bool SocketWire::Base::flush_ack() const
+{
+	unacked_packages = 0;
+	last_ack_time = std::chrono::steady_clock::now();
+
+	std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+	const sequence_number_t seqn = pending_ack_seqn.exchange(0);
+	return seqn == 0 || send_ack0(seqn);
+}
+
 bool SocketWire::Base::try_shutdown_connection() const
 {
 	auto s = get_socket_provider();
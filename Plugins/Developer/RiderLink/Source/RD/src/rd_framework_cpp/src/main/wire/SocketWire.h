@@ -13,7 +13,13 @@
 
 #include <string>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include <rd_framework_export.h>
 
@@ -47,7 +53,9 @@ public:
 
 		mutable std::condition_variable socket_send_var;
 		mutable ByteBufferAsyncProcessor async_send_buffer{id + "-AsyncSendProcessor",
-			[this](Buffer::ByteArray const& it, sequence_number_t seqn) -> bool { return this->send0(it, seqn); }};
+			[this](Buffer::ByteArray const* const* packages, size_t count, sequence_number_t seqn) -> size_t {
+				return this->send0(packages, count, seqn);
+			}};
 
 		static constexpr size_t RECEIVE_BUFFER_SIZE = 1u << 16;
 		mutable std::array<Buffer::word_t, RECEIVE_BUFFER_SIZE> receiver_buffer{};
@@ -58,6 +66,16 @@ public:
 		static constexpr int32_t PACKAGE_HEADER_LENGTH = sizeof(ACK_MESSAGE_LENGTH) + sizeof(sequence_number_t);
 		mutable Buffer ack_buffer{PACKAGE_HEADER_LENGTH};
 
+		/**
+		 * \brief Received packages are acknowledged cumulatively: the latest seqn is sent after [ACK_PACKAGES_THRESHOLD]
+		 * packages or [ACK_DELAY_MS], before the receiver blocks on the socket, or along with the next outgoing batch.
+		 */
+		static constexpr int32_t ACK_PACKAGES_THRESHOLD = 32;
+		static constexpr int32_t ACK_DELAY_MS = 20;
+		mutable std::atomic<sequence_number_t> pending_ack_seqn{0};
+		mutable int32_t unacked_packages = 0;
+		mutable std::chrono::steady_clock::time_point last_ack_time{};
+
 		/**
 		 * \brief Timestamp of this wire which increases at intervals of [heartBeatInterval].
 		 */
@@ -76,15 +94,32 @@ public:
 		mutable Buffer ping_pkg_header{PACKAGE_HEADER_LENGTH};
 
 		mutable sequence_number_t max_received_seqn = 0;
-		mutable Buffer send_package_header{PACKAGE_HEADER_LENGTH};
 
-		static constexpr int32_t CHUNK_SIZE = 16370;
 		mutable int32_t sz = -1;
 		mutable RdId::hash_t id_ = -1;
-		mutable PkgInputStream receive_pkg{[this]() -> int32_t { return this->read_package(); }};
+		mutable PkgInputStream receive_pkg{[this]() -> int32_t { return this->read_package(); },
+			[this](Buffer::word_t* data, size_t len) -> bool { return this->read_package_data(data, len); }};
+
+		// the package receive_pkg reads, acknowledged once all of it is read
+		mutable sequence_number_t package_seqn = 0;
+		mutable int32_t package_remaining = 0;
+
+		/**
+		 * \brief Entities whose messages may be dropped when the send buffer is over its high watermark, e.g. progress
+		 * or telemetry that the next message supersedes anyway.
+		 * [send] reads the published set without locking; [set_droppable] publishes a modified copy and keeps the
+		 * replaced sets alive until the wire is destroyed, since a sender may still be reading one.
+		 */
+		using droppable_set_t = std::unordered_set<RdId::hash_t>;
+		std::mutex droppable_lock;
+		std::vector<std::unique_ptr<droppable_set_t const>> droppable_sets;
+		std::atomic<droppable_set_t const*> droppable_ids{nullptr};
 
-		mutable Buffer message{CHUNK_SIZE};
+		bool is_droppable(RdId const& rd_id) const;
 
+		/**
+		 * \brief Copies [msglen] bytes from the receive buffer to [res], or skips them if [res] is null.
+		 */
 		bool read_from_socket(Buffer::word_t* res, int32_t msglen) const;
 
 		template <typename T>
@@ -100,6 +135,9 @@ public:
 
 		void set_socket_provider(std::shared_ptr<CActiveSocket> new_socket);
 
+		// expects socket_send_lock to be held
+		bool send_ack0(sequence_number_t seqn) const;
+
 		CSimpleSocket* get_socket_provider() const;
 
 	public:
@@ -118,14 +156,30 @@ public:
 
 		int32_t read_package() const;
 
+		bool read_package_data(Buffer::word_t* data, size_t len) const;
+
 		bool read_and_dispatch_message() const;
 
 		void receiverProc() const;
 
-		bool send0(Buffer::ByteArray const& msg, sequence_number_t seqn) const;
+		/**
+		 * \brief Writes the headers and bodies of [count] packages with a single gathering send where possible.
+		 * \return number of packages that were sent completely
+		 */
+		size_t send0(Buffer::ByteArray const* const* packages, size_t count, sequence_number_t seqn) const;
 
 		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const override;
 
+		void set_droppable(RdId const& rd_id, bool droppable);
+
+		/**
+		 * \brief When the outgoing packages not acknowledged yet exceed [high] bytes, [send] blocks the caller until they
+		 * drop under [low] or [block_time] passes, and droppable messages are dropped.
+		 */
+		void set_send_watermarks(size_t low, size_t high, std::chrono::milliseconds block_time);
+
+		ByteBufferAsyncProcessor::Metrics get_send_metrics() const;
+
 		static bool connection_established(int32_t timestamp, int32_t acknowledged_timestamp);
 
 		std::future<void> start_heartbeat(Lifetime lifetime);
@@ -134,6 +188,10 @@ public:
 
 		bool send_ack(sequence_number_t seqn) const;
 
+		void acknowledge_later(sequence_number_t seqn) const;
+
+		bool flush_ack() const;
+
 		bool try_shutdown_connection() const;
 		
 	private:		
@@ -29,6 +29,13 @@ void FRiderLinkModule::ShutdownModule()
 	
 	ModuleLifetimeDef.terminate();
 	ProtocolFactory.Reset();
+	if (Protocol.IsValid())
+	{
+		const rd::ByteBufferAsyncProcessor::Metrics SendMetrics = static_cast<rd::SocketWire::Base*>(Protocol->wire.get())->get_send_metrics();
+		UE_LOG(FLogRiderLinkModule, Verbose, TEXT("Wire: dropped %llu packages (%llu bytes), blocked %llu sends"),
+		       static_cast<uint64>(SendMetrics.dropped_packages), static_cast<uint64>(SendMetrics.dropped_bytes), static_cast<uint64>(SendMetrics.blocked_puts));
+	}
+	UE_LOG(FLogRiderLinkModule, Verbose, TEXT("MainScheduler: %s"), UTF8_TO_TCHAR(rd::to_string(Scheduler.get_stats()).c_str()));
 	UE_LOG(FLogRiderLinkModule, Verbose, TEXT("RiderLink SHUTDOWN FINISH"));
 }
 
@@ -73,6 +80,11 @@ void FRiderLinkModule::InitProtocol()
 			JetBrains::EditorPlugin::UE4Library::serializersOwner.registerSerializersCore(
 				EditorModel->get_serialization_context().get_serializers()
 			);
+			// Log events are the only traffic that can outrun Rider; let the wire drop them instead of blocking the logging thread
+			using FUnrealLogSignal = rd::RdSignal<JetBrains::EditorPlugin::UnrealLogEvent, rd::Polymorphic<JetBrains::EditorPlugin::UnrealLogEvent>>;
+			static_cast<rd::SocketWire::Base*>(Protocol->wire.get())->set_droppable(
+				static_cast<FUnrealLogSignal const&>(EditorModel->get_unrealLog()).get_id(), true
+			);
 			ConnectionLifetime->add_action([&]() mutable
 			{
 				Scheduler.queue([&]()mutable
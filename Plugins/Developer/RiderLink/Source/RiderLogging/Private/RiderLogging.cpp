@@ -118,7 +118,7 @@ void FRiderLoggingModule::StartupModule()
 			const FString PlainName = Name.GetPlainNameString();
 			const JetBrains::EditorPlugin::LogMessageInfo MessageInfo{Type, PlainName, DateTime};
 			
-			LoggingScheduler->queue([Msg = FString(msg), MessageInfo]() mutable
+			LoggingScheduler->queue_task([Msg = FString(msg), MessageInfo]() mutable
 			{
 				LoggingExtensionImpl::ScheduledSendMessage(&Msg, MessageInfo);
 			});
@@ -136,6 +136,11 @@ void FRiderLoggingModule::ShutdownModule()
 {
 	UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("SHUTDOWN START"));
 	ModuleLifetimeDef.terminate();
+	if (LoggingScheduler)
+	{
+		UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("LoggingScheduler: %s"),
+			UTF8_TO_TCHAR(rd::to_string(LoggingScheduler->get_stats()).c_str()));
+	}
 	UE_LOG(FLogRiderLoggingModule, Verbose, TEXT("SHUTDOWN FINISH"));
 }
 
@@ -7,9 +7,8 @@
 // Sets default values for this component's properties
 UACDamageSystem::UACDamageSystem()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// Damage is purely event driven, so this component never needs to tick
+	PrimaryComponentTick.bCanEverTick = false;
 
 	// ...
 }
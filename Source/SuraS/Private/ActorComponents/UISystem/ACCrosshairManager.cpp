@@ -6,6 +6,9 @@
 #include "Characters/Enemies/SuraCharacterEnemyBase.h"
 #include "Characters/Player/SuraCharacterPlayer.h"
 #include "Components/Overlay.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crosshair Tick"), STAT_SuraCrosshairTick, STATGROUP_SuraS);
 
 // Sets default values for this component's properties
 UACCrosshairManager::UACCrosshairManager()
@@ -44,12 +47,16 @@ void UACCrosshairManager::BeginPlay()
 	// 플레이어 컨트롤러 가져오기
 	PlayerController = GetWorld()->GetFirstPlayerController();
 
+	SetComponentTickInterval(TraceInterval);
+
 }
 
 
 // Called every frame
 void UACCrosshairManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraCrosshairTick);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// 크로스헤어 상태 업데이트
@@ -83,7 +90,10 @@ void UACCrosshairManager::InitializeCrosshairWidget()
 
 	if (CrosshairWidgetClass)
 	{
+		LLM_SCOPE_BYTAG(SuraS_UI);
+
 		CrosshairWidget = CreateWidget<UCrosshairWidget>(GetWorld(), CrosshairWidgetClass);
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
 		if (CrosshairWidget)
 		{
 			CrosshairWidget->AddToViewport();
@@ -167,6 +177,8 @@ void UACCrosshairManager::PerformLineTrace()
 	// TraceComplex를 활성화하여 더 정밀한 충돌 처리
 	QueryParams.bTraceComplex = true;
 
+	SURAS_COUNT_TRACE();
+
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		HitResult, Start, End, ECC_Visibility, QueryParams);
 
@@ -4,6 +4,7 @@
 #include "ActorComponents/UISystem/ACUIMangerComponent.h"
 #include "EnhancedInputComponent.h"
 #include "ActorComponents/UISystem/ACCrosshairManager.h"
+#include "SuraSStats.h"
 
 
 // Sets default values for this component's properties
@@ -57,8 +58,10 @@ UBaseUIWidget* UACUIMangerComponent::GetWidget(EUIType UIType)
 	if (!UIWidgets.Contains(UIType))
 	{
 		// 위젯이 없다면 새로 생성
+		LLM_SCOPE_BYTAG(SuraS_UI);
 		UBaseUIWidget* NewWidget = CreateWidget<UBaseUIWidget>(GetWorld(), UIWidgetClasses[UIType]);
 		UE_LOG(LogTemp, Warning, TEXT("Widget created"));
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
         
 		// 새로 생성된 위젯이 있으면 UIWidgets에 저장
 		if (NewWidget)
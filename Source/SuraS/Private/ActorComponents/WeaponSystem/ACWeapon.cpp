@@ -18,6 +18,11 @@
 #include "ActorComponents/WeaponSystem/WeaponCameraShakeBase.h"
 #include "ActorComponents/WeaponSystem/AmmoCounterWidget.h"
 #include "ActorComponents/WeaponSystem/WeaponAimUIWidget.h"
+#include "ActorComponents/WeaponSystem/SuraPlayerAnimInstance_Weapon.h"
+#include "ActorComponents/WeaponSystem/SuraWeaponAnimInstance.h"
+#include "ActorComponents/WeaponSystem/WeaponAssetStreamingManager.h"
+#include "ActorComponents/WeaponSystem/WeaponAudioManager.h"
+#include "SuraSStats.h"
 
 
 #include "GameFramework/PlayerController.h"
@@ -45,6 +50,11 @@
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/CanvasRenderTarget2D.h"
 
+DECLARE_CYCLE_STAT(TEXT("Weapon Tick"), STAT_SuraWeaponTick, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Weapon FireSingleProjectile"), STAT_SuraWeaponFireSingleProjectile, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Weapon FireMultiProjectile"), STAT_SuraWeaponFireMultiProjectile, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Weapon StartFireAnimation"), STAT_SuraWeaponStartFireAnimation, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Weapon UpdateTargetDetection"), STAT_SuraWeaponUpdateTargetDetection, STATGROUP_SuraS);
 
 
 // Sets default values for this component's properties
@@ -173,6 +183,8 @@ UACWeapon::UACWeapon()
 
 void UACWeapon::InitializeWeapon(ASuraCharacterPlayerWeapon* NewCharacter)
 {
+	LLM_SCOPE_BYTAG(SuraS_Weapons);
+
 	Character = NewCharacter;
 	if (Character)
 	{
@@ -228,6 +240,8 @@ void UACWeapon::InitializeCamera(ASuraCharacterPlayerWeapon* NewCharacter)
 
 void UACWeapon::InitializeUI()
 {
+	LLM_SCOPE_BYTAG(SuraS_UI);
+
 	//if (CrosshairWidgetClass)
 	//{
 		//CrosshairWidget = CreateWidget<UUserWidget>(GetWorld(), CrosshairWidgetClass);
@@ -236,6 +250,7 @@ void UACWeapon::InitializeUI()
 	if (AimUIWidgetClass)
 	{
 		AimUIWidget = CreateWidget<UWeaponAimUIWidget>(GetWorld(), AimUIWidgetClass);
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
 	}
 
 	if (AmmoCounterWidgetClass)
@@ -243,6 +258,7 @@ void UACWeapon::InitializeUI()
 		UE_LOG(LogTemp, Error, TEXT("AmmoCounterWidgetClass Is Available!!!"));
 		//AmmoCounterWidget = CreateWidget<UAmmoCounterWidget>(GetWorld(), AmmoCounterWidgetClass, FName(TEXT("AmmoCounterWidget")));
 		AmmoCounterWidget = CreateWidget<UAmmoCounterWidget>(GetWorld(), AmmoCounterWidgetClass);
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
 		//AmmoCounterWidget = CreateWidget<UUserWidget>(GetWorld(), AmmoCounterWidgetClass, FName(TEXT("AmmoCounterWidget")));
 		//if (AmmoCounterWidget)
 		//{
@@ -317,13 +333,15 @@ void UACWeapon::LoadWeaponData(FName WeaponID)
 	{
 		//TODO: The data you load must be different depending on the weapon type
 
-		// <Sound>
-		FireSound = WeaponData->FireSound;
-		ChargeSound = WeaponData->ChargeSound;
+		// <Sound> & <Effect> & <Camera Shake>
+		// soft references, resolved in ResolveWeaponAssets once they are streamed in
+		ResolveWeaponAssets();
+
+		if (UWeaponAssetStreamingManager* StreamingManager = GetWorld()->GetSubsystem<UWeaponAssetStreamingManager>())
+		{
+			StreamingManager->RequestWeaponAssets(this, WeaponName, true, FStreamableDelegate::CreateUObject(this, &UACWeapon::ResolveWeaponAssets));
+		}
 
-		// <Effect>
-		MuzzleFireEffect = WeaponData->FireEffect;
-		ChargeEffect = WeaponData->ChargeEffect;
 		ChargeEffectLocation = WeaponData->ChargeEffectLocation;
 		ChargeEffectRotation = WeaponData->ChargeEffectRotation;
 		ChargeEffenctScale = WeaponData->ChargeEffenctScale;
@@ -353,10 +371,8 @@ void UACWeapon::LoadWeaponData(FName WeaponID)
 		DefaultRecoil = WeaponData->DefaultRecoil;
 		ZoomRecoil = WeaponData->ZoomRecoil;
 
-		// <Camera Shake>
-		DefaultCameraShakeClass = WeaponData->DefaultCameraShakeClass;
-		ZoomCameraShakeClass = WeaponData->ZoomCameraShakeClass;
-		ChargingCameraShakeClass = WeaponData->ChargingCameraShakeClass;
+		// <FireKick>
+		FireKick = WeaponData->FireKick;
 
 		// <Targeting(Homing)>
 		MissileLaunchDelay = WeaponData->MissileLaunchDelay;
@@ -380,6 +396,27 @@ void UACWeapon::LoadWeaponData(FName WeaponID)
 	}
 }
 
+void UACWeapon::ResolveWeaponAssets()
+{
+	if (!WeaponData)
+	{
+		return;
+	}
+
+	// null until streamed in, every user of these already skips a missing asset
+	FireSound = WeaponData->FireSound.Get();
+	FireLoopSound = WeaponData->FireLoopSound.Get();
+	FireTailSound = WeaponData->FireTailSound.Get();
+	ChargeSound = WeaponData->ChargeSound.Get();
+
+	MuzzleFireEffect = WeaponData->FireEffect.Get();
+	ChargeEffect = WeaponData->ChargeEffect.Get();
+
+	DefaultCameraShakeClass = WeaponData->DefaultCameraShakeClass.Get();
+	ZoomCameraShakeClass = WeaponData->ZoomCameraShakeClass.Get();
+	ChargingCameraShakeClass = WeaponData->ChargingCameraShakeClass.Get();
+}
+
 // Called when the game starts
 void UACWeapon::BeginPlay()
 {
@@ -413,6 +450,8 @@ void UACWeapon::BeginPlay()
 
 void UACWeapon::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponTick);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (CurrentState)
@@ -503,6 +542,9 @@ void UACWeapon::DetachWeaponFromPlayer()
 
 void UACWeapon::FireSingleProjectile(bool bShouldConsumeAmmo, float AdditionalDamage, float AdditionalRecoilAmountPitch, float AdditionalRecoilAmountYaw, float AdditionalProjectileRadius, int32 NumPenetrable, bool bIsHoming, AActor* HomingTarget)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponFireSingleProjectile);
+	LLM_SCOPE_BYTAG(SuraS_Projectiles);
+
 	//TODO: Projectile    input ޾ƾ ϳ?   𸣁
 	if (CurrentState != UnequippedState)
 	{
@@ -580,6 +622,7 @@ void UACWeapon::FireSingleProjectile(bool bShouldConsumeAmmo, float AdditionalDa
 
 				// Spawn the projectile at the muzzle
 				ASuraProjectile* Projectile = World->SpawnActor<ASuraProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+				INC_DWORD_STAT(STAT_SuraProjectilesSpawned);
 				Projectile->InitializeProjectile(Character, this, AdditionalDamage, AdditionalProjectileRadius, NumPenetrable);
 				SetUpAimUIDelegateBinding(Projectile);
 				if (bIsHoming)
@@ -593,10 +636,7 @@ void UACWeapon::FireSingleProjectile(bool bShouldConsumeAmmo, float AdditionalDa
 		}
 
 		// Try and play the sound if specified
-		if (FireSound != nullptr)
-		{
-			UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
-		}
+		PlayFireSound();
 
 
 		StartFireAnimation(AM_Fire_Character, AM_Fire_Weapon);
@@ -621,6 +661,9 @@ void UACWeapon::FireSingleProjectile(bool bShouldConsumeAmmo, float AdditionalDa
 
 void UACWeapon::FireMultiProjectile()
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponFireMultiProjectile);
+	LLM_SCOPE_BYTAG(SuraS_Projectiles);
+
 	if (CurrentState != UnequippedState)
 	{
 		if (Character == nullptr || Character->GetController() == nullptr)
@@ -674,6 +717,7 @@ void UACWeapon::FireMultiProjectile()
 						ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
 						ASuraProjectile* Projectile = World->SpawnActor<ASuraProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+						INC_DWORD_STAT(STAT_SuraProjectilesSpawned);
 						Projectile->InitializeProjectile(Character, this);
 						SetUpAimUIDelegateBinding(Projectile);
 						Projectile->LaunchProjectile();
@@ -684,10 +728,7 @@ void UACWeapon::FireMultiProjectile()
 			}
 
 			// Try and play the sound if specified
-			if (FireSound != nullptr)
-			{
-				UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
-			}
+			PlayFireSound();
 
 			StartFireAnimation(AM_Fire_Character, AM_Fire_Weapon);
 
@@ -774,19 +815,41 @@ void UACWeapon::ChangeState(USuraWeaponBaseState* NewState)
 #pragma region Animation
 void UACWeapon::StartFireAnimation(UAnimMontage* CharacterFireAnimation, UAnimMontage* WeaponFireAnimation)
 {
-	if (CharacterAnimInstance != nullptr)
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponStartFireAnimation);
+
+	// <Procedural FireKick>
+	// every shot only queues a spring impulse, the pose is built on the anim worker thread
+	bool bCharacterKicked = false;
+	bool bWeaponKicked = false;
+
+	if (FireKick.bUseProceduralFireKick)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Fire Character Animation!!!"));
+		const float Roll = FMath::FRandRange(FireKick.KickRollMin, FireKick.KickRollMax);
+
+		if (USuraPlayerAnimInstance_Weapon* PlayerAnimInstance = Cast<USuraPlayerAnimInstance_Weapon>(CharacterAnimInstance))
+		{
+			PlayerAnimInstance->QueueFireKick(FireKick, Roll);
+			bCharacterKicked = true;
+		}
 
+		if (USuraWeaponAnimInstance* KickWeaponAnimInstance = Cast<USuraWeaponAnimInstance>(GetAnimInstance()))
+		{
+			KickWeaponAnimInstance->QueueFireKick(FireKick, Roll);
+			bWeaponKicked = true;
+		}
+	}
+
+	// <Montage fallback>
+	if (CharacterAnimInstance != nullptr && !bCharacterKicked)
+	{
 		if (!CharacterAnimInstance->Montage_IsPlaying(CharacterFireAnimation))
 		{
 			CharacterAnimInstance->Montage_Play(CharacterFireAnimation, 0.5f);
 		}
 	}
 
-	if (WeaponAnimInstance != nullptr)
+	if (WeaponAnimInstance != nullptr && !bWeaponKicked)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Fire Weapon Animation!!!"));
 		//WeaponAnimInstance->Montage_Play(WeaponFireAnimation, 1.f);
 		if (!GetAnimInstance()->Montage_IsPlaying(WeaponFireAnimation))
 		{
@@ -843,11 +906,37 @@ void UACWeapon::CancelAnimation(UAnimMontage* CharacterAnimation, UAnimMontage*
 #pragma endregion
 
 
+void UACWeapon::PlayFireSound()
+{
+	if (FireSound == nullptr)
+	{
+		return;
+	}
+
+	// pooled voices with concurrency limits, rapid shots merge into FireLoopSound
+	if (UWeaponAudioManager* AudioManager = GetWorld()->GetSubsystem<UWeaponAudioManager>())
+	{
+		AudioManager->PlayFireSound(this, FireSound, FireLoopSound, FireTailSound);
+	}
+	else
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
+	}
+}
+
 void UACWeapon::PlayChargeSound()
 {
 	if (ChargeSound)
 	{
-		ChargeAudioComponent = UGameplayStatics::SpawnSoundAttached(ChargeSound, this, FName(TEXT("Muzzle")), FVector(0, 0, 0), EAttachLocation::KeepRelativeOffset);
+		if (UWeaponAudioManager* AudioManager = GetWorld()->GetSubsystem<UWeaponAudioManager>())
+		{
+			// the manager keeps one charge voice per weapon and reuses it
+			ChargeAudioComponent = AudioManager->PlayChargeSound(this, ChargeSound);
+		}
+		else
+		{
+			ChargeAudioComponent = UGameplayStatics::SpawnSoundAttached(ChargeSound, this, FName(TEXT("Muzzle")), FVector(0, 0, 0), EAttachLocation::KeepRelativeOffset);
+		}
 	}
 }
 
@@ -862,6 +951,8 @@ void UACWeapon::StopChargeSound()
 #pragma region Niagara
 void UACWeapon::SpawnMuzzleFireEffect(FVector SpawnLocation, FRotator SpawnRotation)
 {
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
 	if (MuzzleFireEffect)
 	{
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
@@ -875,6 +966,8 @@ void UACWeapon::SpawnMuzzleFireEffect(FVector SpawnLocation, FRotator SpawnRotat
 }
 void UACWeapon::SpawnChargeEffect(FVector SpawnLocation, FRotator SpawnRotation, FVector EffectScale)
 {
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
 	if (ChargeEffect)
 	{
 		ChargeEffectComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(
@@ -919,6 +1012,8 @@ bool UACWeapon::PerformLineTrace(FVector StartLocation, FVector LineDirection, f
 	ResponseParams.CollisionResponse.SetResponse(ECC_GameTraceChannel1, ECR_Ignore);
 	ResponseParams.CollisionResponse.SetResponse(ECC_GameTraceChannel3, ECR_Ignore);
 
+	SURAS_COUNT_TRACE();
+
 	bool bHit = GetWorld()->LineTraceSingleByChannel(
 		HitResult,           // 浹  
 		Start,               //  
@@ -956,6 +1051,8 @@ bool UACWeapon::PerformSphereTrace(FVector StartLocation, FVector TraceDirection
 	Params.AddIgnoredComponent(this);
 	Params.AddIgnoredActor(Character);
 
+	SURAS_COUNT_TRACE();
+
 	bool bHit = GetWorld()->SweepSingleByObjectType(
 		HitResult,
 		Start,
@@ -1085,6 +1182,12 @@ void UACWeapon::UnequipWeapon(ASuraCharacterPlayerWeapon* TargetCharacter)
 	ResetInputActionBinding();
 	DetachWeaponFromPlayer();
 
+	// a burst loop or charge sound must not keep playing from the holstered weapon
+	if (UWeaponAudioManager* AudioManager = GetWorld()->GetSubsystem<UWeaponAudioManager>())
+	{
+		AudioManager->StopWeaponSounds(this);
+	}
+
 	UE_LOG(LogTemp, Warning, TEXT("Unequip Weapon!!!"));
 	ChangeState(UnequippedState);
 }
@@ -1213,7 +1316,7 @@ void UACWeapon::ReloadAmmo()
 		AmmoCounterWidget->UpdateAmmoCount(NumOfLeftAmmo);
 	}
 }
-bool UACWeapon::HasAmmo()
+bool UACWeapon::HasAmmo() const
 {
 	return (NumOfLeftAmmo > 0);
 }
@@ -1468,6 +1571,8 @@ void UACWeapon::StartTargetDetection()
 }
 void UACWeapon::UpdateTargetDetection(float DeltaTime) //TODO: ش Ÿ Ȥ  Ÿ  ε Ǵؼ Update ؾ
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponUpdateTargetDetection);
+
 	ElapsedTimeAfterTargetingStarted += DeltaTime;
 
 	TArray<AActor*> NewOverlappedActors;
@@ -1556,6 +1661,7 @@ bool UACWeapon::SearchOverlappedActor(FVector CenterLocation, float SearchRadius
 	traceObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_Pawn));
 	TArray<AActor*> ignoreActors;
 	ignoreActors.Init(Character, 1);
+	SURAS_COUNT_TRACE();
 	bool bIsAnyActorExist = UKismetSystemLibrary::SphereOverlapActors(GetWorld(), CenterLocation, SearchRadius, traceObjectTypes, nullptr, ignoreActors, OverlappedActors);
 
 	return bIsAnyActorExist;
@@ -1698,6 +1804,8 @@ bool UACWeapon::CheckIfTargetIsBlockedByObstacle(AActor* target)
 	QueryParams.bReturnPhysicalMaterial = false;
 	QueryParams.AddIgnoredActor(Character);
 
+	SURAS_COUNT_TRACE();
+
 	bool bHit = GetWorld()->SweepMultiByObjectType(
 		HitResults,
 		StartPoint,
@@ -1713,7 +1821,9 @@ UUserWidget* UACWeapon::CreateTargetMarkerWidget(AActor* TargetActor)
 {
 	if (TargetMarkerWidgetClass)
 	{
+		LLM_SCOPE_BYTAG(SuraS_UI);
 		UUserWidget* NewTargetMarkerWidget = CreateWidget<UUserWidget>(GetWorld(), TargetMarkerWidgetClass);
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
 		MapTargetActorToWidget.Add(TargetActor, NewTargetMarkerWidget);
 		return NewTargetMarkerWidget;
 	}
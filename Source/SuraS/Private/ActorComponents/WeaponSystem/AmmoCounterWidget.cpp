@@ -6,5 +6,11 @@
 
 void UAmmoCounterWidget::UpdateAmmoCount(int32 NewAmmoCount)
 {
-	AmmoCount->SetText(FText::FromString(FString::Printf(TEXT("%d"), NewAmmoCount)));
+	if (NewAmmoCount == DisplayedAmmoCount)
+	{
+		return;
+	}
+
+	DisplayedAmmoCount = NewAmmoCount;
+	AmmoCount->SetText(FText::AsNumber(NewAmmoCount, &FNumberFormattingOptions::DefaultNoGrouping()));
 }
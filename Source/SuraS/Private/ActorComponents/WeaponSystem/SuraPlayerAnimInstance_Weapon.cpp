@@ -118,6 +118,20 @@ void USuraPlayerAnimInstance_Weapon::NativeUpdateAnimation(float DeltaTime)
 	}
 }
 
+void USuraPlayerAnimInstance_Weapon::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	FireKickSpring.Update(DeltaSeconds);
+	FireKickLocation = FireKickSpring.GetKickLocation();
+	FireKickRotation = FireKickSpring.GetKickRotation();
+}
+
+void USuraPlayerAnimInstance_Weapon::QueueFireKick(const FWeaponFireKickStruct& FireKick, float Roll)
+{
+	FireKickSpring.QueueShot(FireKick, Roll);
+}
+
 void USuraPlayerAnimInstance_Weapon::UpdateWeapon()
 {
 	if (IsValid(Character->GetWeaponSystem())
@@ -3,6 +3,7 @@
 #include "ActorComponents/WeaponSystem/SuraProjectile.h"
 
 #include "ActorComponents/WeaponSystem/ACWeapon.h"
+#include "SuraSStats.h"
 
 #include "Interfaces/Damageable.h"
 #include "Structures/DamageData.h"
@@ -18,6 +19,9 @@
 
 #include "Kismet/GameplayStatics.h"
 
+DECLARE_CYCLE_STAT(TEXT("Projectile OnHit"), STAT_SuraProjectileOnHit, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Projectile BeginOverlap"), STAT_SuraProjectileBeginOverlap, STATGROUP_SuraS);
+
 // Sets default values
 ASuraProjectile::ASuraProjectile()
 {
@@ -86,30 +90,12 @@ void ASuraProjectile::InitializeProjectile(AActor* OwnerOfProjectile, UACWeapon*
 	{
 		ProjectileOwner = OwnerOfProjectile;
 
-		if (ProjectileType == EProjectileType::Projectile_Rifle)
-		{
-			//UE_LOG(LogTemp, Warning, TEXT("Rifle Projectile!!!"));
-			LoadProjectileData("RifleProjectile");
-			SpawnTrailEffect();
-		}
-		else if (ProjectileType == EProjectileType::Projectile_ShotGun)
-		{
-			//UE_LOG(LogTemp, Warning, TEXT("ShotGun Projectile!!!"));
-			LoadProjectileData("ShotGunProjectile");
-			SpawnTrailEffect();
-		}
-		else if (ProjectileType == EProjectileType::Projectile_BasicRocket)
+		const FName ProjectileRowName = GetProjectileDataRowName();
+		if (!ProjectileRowName.IsNone())
 		{
-			//UE_LOG(LogTemp, Warning, TEXT("BasicRocket Projectile!!!"));
-			LoadProjectileData("BasicRocketProjectile");
+			LoadProjectileData(ProjectileRowName);
 			SpawnTrailEffect();
 		}
-		else if (ProjectileType == EProjectileType::Projectile_RailGun)
-		{
-			LoadProjectileData("RailGunProjectile");
-			SpawnTrailEffect();
-			//SpawnTrailEffect(true);
-		}
 	}
 
 	if (bCanPenetrate)
@@ -143,9 +129,10 @@ void ASuraProjectile::LoadProjectileData(FName ProjectileID)
 	ProjectileData = ProjectileDataTable->FindRow<FProjectileData>(ProjectileID, TEXT(""));
 	if (ProjectileData)
 	{
-		TrailEffect = ProjectileData->TrailEffect;
-		ImpactEffect = ProjectileData->ImpactEffect;
-		DecalMaterial = ProjectileData->HoleDecal;
+		// soft references streamed in with the owning weapon, no effect until they are resident
+		TrailEffect = ProjectileData->TrailEffect.Get();
+		ImpactEffect = ProjectileData->ImpactEffect.Get();
+		DecalMaterial = ProjectileData->HoleDecal.Get();
 
 		InitialLifeSpan = ProjectileData->InitialLifeSpan; //TODO ̷Դ  ȵ.  
 		SetLifeSpan(ProjectileData->InitialLifeSpan);
@@ -174,6 +161,23 @@ void ASuraProjectile::LoadProjectileData(FName ProjectileID)
 	}
 }
 
+FName ASuraProjectile::GetProjectileDataRowName() const
+{
+	switch (ProjectileType)
+	{
+	case EProjectileType::Projectile_Rifle:
+		return TEXT("RifleProjectile");
+	case EProjectileType::Projectile_ShotGun:
+		return TEXT("ShotGunProjectile");
+	case EProjectileType::Projectile_BasicRocket:
+		return TEXT("BasicRocketProjectile");
+	case EProjectileType::Projectile_RailGun:
+		return TEXT("RailGunProjectile");
+	default:
+		return NAME_None;
+	}
+}
+
 void ASuraProjectile::SetHomingTarget(bool bIsHoming, AActor* Target)
 {
 	ProjectileMovement->bIsHomingProjectile = bIsHoming;
@@ -236,6 +240,7 @@ bool ASuraProjectile::SearchOverlappedActor(FVector CenterLocation, float Search
 	traceObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_Pawn));
 	TArray<AActor*> ignoreActors;
 	ignoreActors.Init(ProjectileOwner, 1);
+	SURAS_COUNT_TRACE();
 	bool bIsAnyActorExist = UKismetSystemLibrary::SphereOverlapActors(GetWorld(), CenterLocation, SearchRadius, traceObjectTypes, nullptr, ignoreActors, OverlappedActors);
 
 	return bIsAnyActorExist;
@@ -243,6 +248,8 @@ bool ASuraProjectile::SearchOverlappedActor(FVector CenterLocation, float Search
 
 void ASuraProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraProjectileOnHit);
+
 	//TODO: Projectile ٸ actor hit  , OtherActor   ٸ event ߻Ű. Interface ϱ
 	if (bCanPenetrate)
 	{
@@ -322,6 +329,8 @@ void ASuraProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UP
 
 void ASuraProjectile::OnComponentBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraProjectileBeginOverlap);
+
 	if (bCanPenetrate)
 	{
 		if (OtherActor != nullptr)
@@ -386,6 +395,8 @@ void ASuraProjectile::OnComponentBeginOverlap(UPrimitiveComponent* OverlappedCom
 
 void ASuraProjectile::SpawnImpactEffect(FVector SpawnLocation, FRotator SpawnRotation)
 {
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
 	if (ImpactEffect)
 	{
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), ImpactEffect, SpawnLocation, SpawnRotation, FVector(1.0f), true);
@@ -393,6 +404,8 @@ void ASuraProjectile::SpawnImpactEffect(FVector SpawnLocation, FRotator SpawnRot
 }
 void ASuraProjectile::SpawnTrailEffect(bool bShouldAttachedToWeapon) //TODO: Rocket Trail  ̻. պ
 {
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
 	if (ProjectileMesh && TrailEffect)
 	{ 
 		FTransform TrailStartTransform = ProjectileMesh->GetSocketTransform(FName(TEXT("TrailStart")), ERelativeTransformSpace::RTS_Component);
@@ -446,6 +459,8 @@ void ASuraProjectile::SpawnTrailEffect(bool bShouldAttachedToWeapon) //TODO: Roc
 }
 void ASuraProjectile::SpawnDecalEffect(FVector SpawnLocation, FRotator SpawnRotation)
 {
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
 	if (DecalMaterial)
 	{
 		FVector DecalSize = FVector(2.0f, 8.0f, 8.0f);     // X: β, YZ: ũ
@@ -515,13 +530,14 @@ bool ASuraProjectile::CheckHeadOvelap(const AActor* OverlappedActor, const FHitR
 }
 #pragma endregion
 
-//// Called when the game starts or when spawned
-//void ASuraProjectile::BeginPlay()
-//{
-//	Super::BeginPlay();
-//	
-//}
-//
+// Called when the game starts or when spawned
+void ASuraProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	INC_DWORD_STAT(STAT_SuraLiveProjectiles);
+}
+
 void ASuraProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -533,6 +549,8 @@ void ASuraProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	DEC_DWORD_STAT(STAT_SuraLiveProjectiles);
+
 	if (TrailEffectComponent)
 	{
 		if (bShouldUpdateTrailEffect)
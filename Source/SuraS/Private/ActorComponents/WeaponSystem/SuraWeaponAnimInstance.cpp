@@ -17,4 +17,11 @@ void USuraWeaponAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds
 {
 	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
+	FireKickSpring.Update(DeltaSeconds);
+	FireSlideOffset = FireKickSpring.GetSlideOffset();
+}
+
+void USuraWeaponAnimInstance::QueueFireKick(const FWeaponFireKickStruct& FireKick, float Roll)
+{
+	FireKickSpring.QueueShot(FireKick, Roll);
 }
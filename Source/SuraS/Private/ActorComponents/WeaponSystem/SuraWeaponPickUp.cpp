@@ -4,6 +4,7 @@
 #include "ActorComponents/WeaponSystem/ACWeapon.h"
 #include "ActorComponents/WeaponSystem/SuraPickUpComponent.h"
 #include "ActorComponents/WeaponSystem/WeaponName.h"
+#include "ActorComponents/WeaponSystem/WeaponAssetStreamingManager.h"
 
 #include "Characters/SuraCharacterBase.h"
 #include "ActorComponents/WeaponSystem/SuraCharacterPlayerWeapon.h"
@@ -37,6 +38,12 @@ void ASuraWeaponPickUp::BeginPlay()
 	//PickUpComponent->AttachToComponent(Weapon, AttachRule);
 	PickUpComponent->AttachToComponent(WeaponMesh, AttachRule);
 
+	// the weapon's effects and sounds are streamed in once the player gets close
+	if (UWeaponAssetStreamingManager* StreamingManager = GetWorld()->GetSubsystem<UWeaponAssetStreamingManager>())
+	{
+		StreamingManager->RegisterPickUp(this);
+	}
+
 	////TODO:  ٲ  
 	//if (PickUpComponent)
 	//{
@@ -44,6 +51,16 @@ void ASuraWeaponPickUp::BeginPlay()
 	//}
 }
 
+void ASuraWeaponPickUp::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWeaponAssetStreamingManager* StreamingManager = GetWorld()->GetSubsystem<UWeaponAssetStreamingManager>())
+	{
+		StreamingManager->UnregisterPickUp(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void ASuraWeaponPickUp::Tick(float DeltaTime)
 {
@@ -7,6 +7,7 @@
 #include "Components/CanvasPanelSlot.h"
 #include "Components/Image.h"
 #include "Components/Overlay.h"
+#include "TimerManager.h"
 
 void UWeaponAimUIWidget::NativeConstruct()
 {
@@ -15,11 +16,14 @@ void UWeaponAimUIWidget::NativeConstruct()
     //UE_LOG(LogTemp, Error, TEXT("UWeaponAimUIWidget::NativeConstruct()!!!"));
 }
 
-void UWeaponAimUIWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UWeaponAimUIWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    Super::NativeDestruct();
 
-    UpdateHitIndicator(InDeltaTime);
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(HitIndicatorTimerHandle);
+    }
 }
 
 #pragma region Spread
@@ -33,9 +37,19 @@ void UWeaponAimUIWidget::ResetAimUISize()
             CanvasSlot->SetSize(DefaultOutCircleSize);
         }
     }
+
+    AppliedSpreadValue = 0.f;
 }
 void UWeaponAimUIWidget::ApplyAimUISpread(float SpreadValue)
 {
+    // called every frame while the weapon is spreading, only touch the slot when the size visibly changes
+    if (FMath::Abs(SpreadValue - AppliedSpreadValue) < MinSpreadChangeToResize)
+    {
+        return;
+    }
+
+    AppliedSpreadValue = SpreadValue;
+
     if (OutCircle)
     {
         UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(OutCircle->Slot);
@@ -61,10 +75,18 @@ void UWeaponAimUIWidget::HeadShot()
 
     SetNormalOvelayInvisible();
 
+    CriticalOverlay->SetRenderOpacity(0.f);
+    CriticalOverlay->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+    if (CriticalHitAnimation)
+    {
+        PlayAnimation(CriticalHitAnimation);
+        return;
+    }
+
     bIsIndicatingCriticalHit = true;
     CriticalOverlayFadeOutTimer = 0.f;
-    CriticalOverlay->SetRenderOpacity(0.f);
-    CriticalOverlay->SetVisibility(ESlateVisibility::Visible);
+    StartHitIndicatorTimer();
 }
 
 void UWeaponAimUIWidget::BodyShot()
@@ -73,10 +95,18 @@ void UWeaponAimUIWidget::BodyShot()
 
     SetCriticalOvelayInvisible();
 
+    NormalOverlay->SetRenderOpacity(0.f);
+    NormalOverlay->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+    if (NormalHitAnimation)
+    {
+        PlayAnimation(NormalHitAnimation);
+        return;
+    }
+
     bIsIndicatingNormalHit = true;
     NormalOverlayFadeOutTimer = 0.f;
-    NormalOverlay->SetRenderOpacity(0.f);
-    NormalOverlay->SetVisibility(ESlateVisibility::Visible);
+    StartHitIndicatorTimer();
 }
 
 void UWeaponAimUIWidget::FadeInCriticalOverlay(float DeltaTime)
@@ -131,6 +161,11 @@ void UWeaponAimUIWidget::FadeOutNormalOverlay(float DeltaTime)
 
 void UWeaponAimUIWidget::SetCriticalOvelayInvisible()
 {
+    if (CriticalHitAnimation)
+    {
+        StopAnimation(CriticalHitAnimation);
+    }
+
     bIsIndicatingCriticalHit = false;
     CurrentCriticalOverlayOpacity = 0.f;
     CriticalOverlay->SetRenderOpacity(0.f);
@@ -138,6 +173,11 @@ void UWeaponAimUIWidget::SetCriticalOvelayInvisible()
 
 void UWeaponAimUIWidget::SetNormalOvelayInvisible()
 {
+    if (NormalHitAnimation)
+    {
+        StopAnimation(NormalHitAnimation);
+    }
+
     bIsIndicatingNormalHit = false;
     CurrentNormalOverlayOpacity = 0.f;
     NormalOverlay->SetRenderOpacity(0.f);
@@ -169,4 +209,25 @@ void UWeaponAimUIWidget::UpdateHitIndicator(float DeltaTime)
         }
     }
 }
+
+void UWeaponAimUIWidget::StartHitIndicatorTimer()
+{
+    UWorld* World = GetWorld();
+
+    if (World && !World->GetTimerManager().IsTimerActive(HitIndicatorTimerHandle))
+    {
+        World->GetTimerManager().SetTimer(HitIndicatorTimerHandle, this, &UWeaponAimUIWidget::OnHitIndicatorTimer, HitIndicatorUpdateInterval, true);
+    }
+}
+
+void UWeaponAimUIWidget::OnHitIndicatorTimer()
+{
+    UpdateHitIndicator(HitIndicatorUpdateInterval);
+
+    // both faded out, nothing left to update until the next hit
+    if (!bIsIndicatingCriticalHit && !bIsIndicatingNormalHit)
+    {
+        GetWorld()->GetTimerManager().ClearTimer(HitIndicatorTimerHandle);
+    }
+}
 #pragma endregion
\ No newline at end of file
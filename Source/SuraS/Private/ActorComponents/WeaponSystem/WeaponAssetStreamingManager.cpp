@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorComponents/WeaponSystem/WeaponAssetStreamingManager.h"
+#include "ActorComponents/WeaponSystem/ACWeapon.h"
+#include "ActorComponents/WeaponSystem/SuraProjectile.h"
+#include "ActorComponents/WeaponSystem/SuraWeaponPickUp.h"
+#include "ActorComponents/WeaponSystem/WeaponData.h"
+#include "ActorComponents/WeaponSystem/ProjectileData.h"
+#include "Preload/SuraPreloadManager.h"
+
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace
+{
+	template<typename SoftPtrType>
+	void AddSoftPath(const SoftPtrType& SoftPtr, TArray<FSoftObjectPath>& OutPaths)
+	{
+		if (!SoftPtr.IsNull())
+		{
+			OutPaths.AddUnique(SoftPtr.ToSoftObjectPath());
+		}
+	}
+}
+
+bool UWeaponAssetStreamingManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWeaponAssetStreamingManager::Deinitialize()
+{
+	for (TPair<FName, FWeaponAssetRequest>& Request : WeaponRequests)
+	{
+		if (Request.Value.Handle.IsValid())
+			Request.Value.Handle->ReleaseHandle();
+	}
+
+	WeaponRequests.Empty();
+	PickUps.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWeaponAssetStreamingManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+
+	if (TimeSinceLastUpdate >= UpdateInterval)
+	{
+		TimeSinceLastUpdate = 0.f;
+		UpdatePickUps();
+	}
+}
+
+TStatId UWeaponAssetStreamingManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponAssetStreamingManager, STATGROUP_Tickables);
+}
+
+FName UWeaponAssetStreamingManager::GetWeaponRowName(EWeaponName WeaponName)
+{
+	switch (WeaponName)
+	{
+	case EWeaponName::WeaponName_Rifle:
+		return TEXT("Rifle");
+	case EWeaponName::WeaponName_ShotGun:
+		return TEXT("ShotGun");
+	case EWeaponName::WeaponName_MissileLauncher:
+		return TEXT("MissileLauncher");
+	case EWeaponName::WeaponName_RailGun:
+		return TEXT("RailGun");
+	default:
+		return NAME_None;
+	}
+}
+
+void UWeaponAssetStreamingManager::RegisterPickUp(ASuraWeaponPickUp* PickUp)
+{
+	if (PickUp)
+		PickUps.AddUnique(PickUp);
+}
+
+void UWeaponAssetStreamingManager::UnregisterPickUp(ASuraWeaponPickUp* PickUp)
+{
+	PickUps.Remove(PickUp);
+}
+
+void UWeaponAssetStreamingManager::GatherWeaponAssetPaths(const UACWeapon* Weapon, EWeaponName WeaponName, TArray<FSoftObjectPath>& OutPaths)
+{
+	const FName WeaponRowName = GetWeaponRowName(WeaponName);
+
+	if (Weapon->WeaponDataTable && !WeaponRowName.IsNone())
+	{
+		if (const FWeaponData* WeaponData = Weapon->WeaponDataTable->FindRow<FWeaponData>(WeaponRowName, TEXT("")))
+		{
+			AddSoftPath(WeaponData->FireEffect, OutPaths);
+			AddSoftPath(WeaponData->ChargeEffect, OutPaths);
+			AddSoftPath(WeaponData->FireSound, OutPaths);
+			AddSoftPath(WeaponData->FireLoopSound, OutPaths);
+			AddSoftPath(WeaponData->FireTailSound, OutPaths);
+			AddSoftPath(WeaponData->ChargeSound, OutPaths);
+			AddSoftPath(WeaponData->DefaultCameraShakeClass, OutPaths);
+			AddSoftPath(WeaponData->ZoomCameraShakeClass, OutPaths);
+			AddSoftPath(WeaponData->ChargingCameraShakeClass, OutPaths);
+		}
+	}
+
+	// the projectile's effects come with the weapon that fires it
+	const ASuraProjectile* Projectile = Weapon->ProjectileClass ? Weapon->ProjectileClass->GetDefaultObject<ASuraProjectile>() : nullptr;
+	const FName ProjectileRowName = Projectile ? Projectile->GetProjectileDataRowName() : NAME_None;
+
+	if (Projectile && Projectile->GetProjectileDataTable() && !ProjectileRowName.IsNone())
+	{
+		if (const FProjectileData* ProjectileData = Projectile->GetProjectileDataTable()->FindRow<FProjectileData>(ProjectileRowName, TEXT("")))
+		{
+			AddSoftPath(ProjectileData->TrailEffect, OutPaths);
+			AddSoftPath(ProjectileData->ImpactEffect, OutPaths);
+			AddSoftPath(ProjectileData->HoleDecal, OutPaths);
+		}
+	}
+}
+
+void UWeaponAssetStreamingManager::RequestWeaponAssets(const UACWeapon* Weapon, EWeaponName WeaponName, bool bPin, FStreamableDelegate OnLoaded)
+{
+	if (!Weapon)
+		return;
+
+	const FName RowName = GetWeaponRowName(WeaponName);
+
+	if (RowName.IsNone())
+		return;
+
+	FWeaponAssetRequest& Request = WeaponRequests.FindOrAdd(RowName);
+	Request.bPinned |= bPin;
+
+	if (Request.Handle.IsValid() && Request.Handle->HasLoadCompleted())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	// still loading, the callback is run along with the others when the handle completes
+	if (Request.Handle.IsValid())
+	{
+		if (OnLoaded.IsBound())
+			Request.OnLoadedCallbacks.Add(MoveTemp(OnLoaded));
+
+		return;
+	}
+
+	TArray<FSoftObjectPath> AssetPaths;
+	GatherWeaponAssetPaths(Weapon, WeaponName, AssetPaths);
+
+	if (AssetPaths.IsEmpty())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	// anything not resident yet should have been in the level's preload manifest
+	if (USuraPreloadManager* PreloadManager = GetWorld()->GetSubsystem<USuraPreloadManager>())
+	{
+		for (const FSoftObjectPath& AssetPath : AssetPaths)
+		{
+			if (!AssetPath.ResolveObject())
+				PreloadManager->ReportLazyLoad(AssetPath);
+		}
+	}
+
+	if (OnLoaded.IsBound())
+		Request.OnLoadedCallbacks.Add(MoveTemp(OnLoaded));
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetPaths),
+		FStreamableDelegate::CreateUObject(this, &UWeaponAssetStreamingManager::OnWeaponAssetsLoaded, RowName), FStreamableManager::AsyncLoadHighPriority);
+
+	// the callbacks may have requested other weapons meanwhile, which can move Request
+	WeaponRequests.FindOrAdd(RowName).Handle = MoveTemp(Handle);
+}
+
+void UWeaponAssetStreamingManager::OnWeaponAssetsLoaded(FName RowName)
+{
+	FWeaponAssetRequest* Request = WeaponRequests.Find(RowName);
+
+	if (!Request)
+		return;
+
+	const TArray<FStreamableDelegate> OnLoadedCallbacks = MoveTemp(Request->OnLoadedCallbacks);
+	Request->OnLoadedCallbacks.Reset();
+
+	for (const FStreamableDelegate& OnLoaded : OnLoadedCallbacks)
+		OnLoaded.ExecuteIfBound();
+}
+
+bool UWeaponAssetStreamingManager::AreWeaponAssetsLoaded(FName RowName) const
+{
+	const FWeaponAssetRequest* Request = WeaponRequests.Find(RowName);
+
+	return Request && Request->Handle.IsValid() && Request->Handle->HasLoadCompleted();
+}
+
+void UWeaponAssetStreamingManager::UpdatePickUps()
+{
+	PickUps.RemoveAll([](const TWeakObjectPtr<ASuraWeaponPickUp>& PickUp) { return !PickUp.IsValid(); });
+
+	const APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+
+	if (!Player)
+		return;
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+	const float StreamingRangeSquared = FMath::Square(StreamingRange);
+	const float ReleaseRangeSquared = FMath::Square(ReleaseRange);
+
+	TSet<FName> RowsInReleaseRange;
+
+	for (const TWeakObjectPtr<ASuraWeaponPickUp>& PickUpPtr : PickUps)
+	{
+		const ASuraWeaponPickUp* PickUp = PickUpPtr.Get();
+		const UACWeapon* Weapon = PickUp->GetWeaponClass() ? PickUp->GetWeaponClass()->GetDefaultObject<UACWeapon>() : nullptr;
+
+		if (!Weapon)
+			continue;
+
+		const float DistanceSquared = FVector::DistSquared(PlayerLocation, PickUp->GetActorLocation());
+
+		if (DistanceSquared > ReleaseRangeSquared)
+			continue;
+
+		RowsInReleaseRange.Add(GetWeaponRowName(PickUp->GetWeaponName()));
+
+		if (DistanceSquared <= StreamingRangeSquared)
+			RequestWeaponAssets(Weapon, PickUp->GetWeaponName(), false);
+	}
+
+	for (auto It = WeaponRequests.CreateIterator(); It; ++It)
+	{
+		if (It->Value.bPinned || RowsInReleaseRange.Contains(It->Key))
+			continue;
+
+		if (It->Value.Handle.IsValid())
+			It->Value.Handle->ReleaseHandle();
+
+		It.RemoveCurrent();
+	}
+}
@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorComponents/WeaponSystem/WeaponAudioManager.h"
+
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundConcurrency.h"
+#include "SuraSStats.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Audio Pooled Voices"), STAT_WeaponAudioPooledVoices, STATGROUP_SuraS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Audio Playing Voices"), STAT_WeaponAudioPlayingVoices, STATGROUP_SuraS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Audio Looping Bursts"), STAT_WeaponAudioLoopingBursts, STATGROUP_SuraS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Fire Sound Requests"), STAT_WeaponAudioFireRequests, STATGROUP_SuraS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Audio Shots Merged Into Loop"), STAT_WeaponAudioMergedShots, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Audio PlayFireSound"), STAT_WeaponAudioPlayFireSound, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Audio UpdateVoices"), STAT_WeaponAudioUpdateVoices, STATGROUP_SuraS);
+
+bool UWeaponAudioManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWeaponAudioManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// per owner: the player's (or an enemy's) own rapid fire can't take every voice
+	PerOwnerFireConcurrency = NewObject<USoundConcurrency>(this, TEXT("PerOwnerFireConcurrency"));
+	PerOwnerFireConcurrency->Concurrency.MaxCount = MaxFireVoicesPerWeapon;
+	PerOwnerFireConcurrency->Concurrency.bLimitToOwner = true;
+	PerOwnerFireConcurrency->Concurrency.ResolutionRule = EMaxConcurrentResolutionRule::StopOldest;
+
+	GlobalFireConcurrency = NewObject<USoundConcurrency>(this, TEXT("GlobalFireConcurrency"));
+	GlobalFireConcurrency->Concurrency.MaxCount = MaxFireVoicesGlobal;
+	GlobalFireConcurrency->Concurrency.ResolutionRule = EMaxConcurrentResolutionRule::StopFarthestThenOldest;
+}
+
+void UWeaponAudioManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+
+	if (TimeSinceLastUpdate >= UpdateInterval)
+	{
+		TimeSinceLastUpdate = 0.f;
+		UpdateVoices();
+	}
+}
+
+TStatId UWeaponAudioManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponAudioManager, STATGROUP_Tickables);
+}
+
+UAudioComponent* UWeaponAudioManager::CreateVoice(USceneComponent* Weapon, FName SocketName, bool bUseFireConcurrency) const
+{
+	LLM_SCOPE_BYTAG(SuraS_FX);
+
+	UAudioComponent* Voice = NewObject<UAudioComponent>(Weapon);
+	Voice->bAutoActivate = false;
+	Voice->bAutoDestroy = false;
+	Voice->bStopWhenOwnerDestroyed = true;
+
+	if (bUseFireConcurrency)
+	{
+		Voice->ConcurrencySet.Add(PerOwnerFireConcurrency);
+		Voice->ConcurrencySet.Add(GlobalFireConcurrency);
+	}
+
+	Voice->SetupAttachment(Weapon, SocketName);
+	Voice->RegisterComponent();
+
+	return Voice;
+}
+
+UAudioComponent* UWeaponAudioManager::AcquireFireVoice(USceneComponent* Weapon, FWeaponVoices& Voices, FName SocketName)
+{
+	Voices.FireVoices.RemoveAll([](const TWeakObjectPtr<UAudioComponent>& Voice) { return !Voice.IsValid(); });
+
+	// an idle voice if there is one
+	for (const TWeakObjectPtr<UAudioComponent>& Voice : Voices.FireVoices)
+	{
+		if (!Voice->IsPlaying())
+			return Voice.Get();
+	}
+
+	if (Voices.FireVoices.Num() < MaxFireVoicesPerWeapon)
+	{
+		UAudioComponent* Voice = CreateVoice(Weapon, SocketName, true);
+		Voices.FireVoices.Add(Voice);
+		return Voice;
+	}
+
+	// all busy, restart the one whose turn it is (round robin is the oldest)
+	UAudioComponent* Voice = Voices.FireVoices[Voices.NextFireVoice % Voices.FireVoices.Num()].Get();
+	Voices.NextFireVoice = (Voices.NextFireVoice + 1) % Voices.FireVoices.Num();
+	return Voice;
+}
+
+void UWeaponAudioManager::PlayFireSound(USceneComponent* Weapon, USoundBase* FireSound, USoundBase* LoopSound, USoundBase* TailSound, FName SocketName)
+{
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_WeaponAudioPlayFireSound);
+
+	if (!Weapon || !FireSound)
+		return;
+
+	INC_DWORD_STAT(STAT_WeaponAudioFireRequests);
+
+	FWeaponVoices& Voices = Weapons.FindOrAdd(Weapon);
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (Voices.LastShotTime >= 0.0 && CurrentTime - Voices.LastShotTime <= BurstShotInterval)
+		++Voices.RapidShotCount;
+	else
+		Voices.RapidShotCount = 1;
+
+	Voices.LastShotTime = CurrentTime;
+
+	// <Burst Loop>
+	if (LoopSound && Voices.RapidShotCount >= BurstStartShots)
+	{
+		if (!Voices.bIsLooping)
+		{
+			if (!Voices.LoopVoice.IsValid())
+				Voices.LoopVoice = CreateVoice(Weapon, SocketName, true);
+
+			Voices.LoopVoice->SetSound(LoopSound);
+			Voices.LoopVoice->Play();
+			Voices.TailSound = TailSound;
+			Voices.bIsLooping = true;
+
+			INC_DWORD_STAT(STAT_WeaponAudioLoopingBursts);
+		}
+
+		INC_DWORD_STAT(STAT_WeaponAudioMergedShots);
+		return;
+	}
+
+	// <One Shot>
+	if (UAudioComponent* Voice = AcquireFireVoice(Weapon, Voices, SocketName))
+	{
+		Voice->SetSound(FireSound);
+		Voice->Play();
+	}
+}
+
+UAudioComponent* UWeaponAudioManager::PlayChargeSound(USceneComponent* Weapon, USoundBase* ChargeSound, FName SocketName)
+{
+	if (!Weapon || !ChargeSound)
+		return nullptr;
+
+	FWeaponVoices& Voices = Weapons.FindOrAdd(Weapon);
+
+	if (!Voices.ChargeVoice.IsValid())
+		Voices.ChargeVoice = CreateVoice(Weapon, SocketName, false);
+
+	Voices.ChargeVoice->SetSound(ChargeSound);
+	Voices.ChargeVoice->Play();
+
+	return Voices.ChargeVoice.Get();
+}
+
+void UWeaponAudioManager::StopBurst(USceneComponent* Weapon, FWeaponVoices& Voices, FName SocketName)
+{
+	if (!Voices.bIsLooping)
+		return;
+
+	Voices.bIsLooping = false;
+	Voices.RapidShotCount = 0;
+
+	DEC_DWORD_STAT(STAT_WeaponAudioLoopingBursts);
+
+	if (Voices.LoopVoice.IsValid())
+		Voices.LoopVoice->FadeOut(LoopFadeOutTime, 0.f);
+
+	if (Weapon && Voices.TailSound.IsValid())
+	{
+		if (UAudioComponent* Voice = AcquireFireVoice(Weapon, Voices, SocketName))
+		{
+			Voice->SetSound(Voices.TailSound.Get());
+			Voice->Play();
+		}
+	}
+}
+
+void UWeaponAudioManager::StopWeaponSounds(USceneComponent* Weapon)
+{
+	FWeaponVoices* Voices = Weapons.Find(Weapon);
+
+	if (!Voices)
+		return;
+
+	if (Voices->bIsLooping)
+	{
+		Voices->TailSound.Reset();
+		StopBurst(Weapon, *Voices, NAME_None);
+	}
+
+	if (Voices->ChargeVoice.IsValid())
+		Voices->ChargeVoice->Stop();
+}
+
+void UWeaponAudioManager::UpdateVoices()
+{
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_WeaponAudioUpdateVoices);
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	int32 NumPooled = 0;
+	int32 NumPlaying = 0;
+
+	for (auto It = Weapons.CreateIterator(); It; ++It)
+	{
+		USceneComponent* Weapon = It->Key.Get();
+		FWeaponVoices& Voices = It->Value;
+
+		// weapon gone, its voices went with it
+		if (!Weapon)
+		{
+			if (Voices.bIsLooping)
+				DEC_DWORD_STAT(STAT_WeaponAudioLoopingBursts);
+
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (Voices.bIsLooping && CurrentTime - Voices.LastShotTime > BurstShotInterval)
+		{
+			StopBurst(Weapon, Voices, Voices.LoopVoice.IsValid() ? Voices.LoopVoice->GetAttachSocketName() : NAME_None);
+		}
+
+		for (const TWeakObjectPtr<UAudioComponent>& Voice : Voices.FireVoices)
+		{
+			if (Voice.IsValid())
+			{
+				++NumPooled;
+				NumPlaying += Voice->IsPlaying() ? 1 : 0;
+			}
+		}
+
+		for (const TWeakObjectPtr<UAudioComponent>& Voice : { Voices.LoopVoice, Voices.ChargeVoice })
+		{
+			if (Voice.IsValid())
+			{
+				++NumPooled;
+				NumPlaying += Voice->IsPlaying() ? 1 : 0;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WeaponAudioPooledVoices, NumPooled);
+	SET_DWORD_STAT(STAT_WeaponAudioPlayingVoices, NumPlaying);
+}
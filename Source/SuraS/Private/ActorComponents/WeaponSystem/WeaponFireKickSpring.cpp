@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ActorComponents/WeaponSystem/WeaponFireKickSpring.h"
+
+namespace
+{
+	// keep the integration stable for stiff springs at low frame rates
+	constexpr float MaxSubstepTime = 1.f / 120.f;
+	constexpr int32 MaxSubsteps = 8;
+}
+
+void FWeaponFireKickSpring::QueueShot(const FWeaponFireKickStruct& InSettings, float Roll)
+{
+	const uint32 Write = PendingWrite.load(std::memory_order_relaxed);
+
+	// the anim thread hasn't caught up, the spring already got a full frame of kicks
+	if (Write - PendingRead.load(std::memory_order_acquire) >= MaxPendingShots)
+	{
+		return;
+	}
+
+	PendingShots[Write % MaxPendingShots] = { InSettings, Roll };
+	PendingWrite.store(Write + 1, std::memory_order_release);
+}
+
+void FWeaponFireKickSpring::Update(float DeltaTime)
+{
+	const uint32 Write = PendingWrite.load(std::memory_order_acquire);
+	uint32 Read = PendingRead.load(std::memory_order_relaxed);
+
+	for (; Read != Write; ++Read)
+	{
+		const FShot& Shot = PendingShots[Read % MaxPendingShots];
+		Settings = Shot.Settings;
+
+		// an undamped spring starting at rest with velocity V peaks at V / sqrt(K)
+		const float Omega = FMath::Sqrt(Settings.Stiffness);
+		Velocity += FVector(Settings.KickBack, Settings.KickPitch, Shot.Roll) * Omega;
+		SlideVelocity += Settings.SlideBack * Omega;
+	}
+
+	PendingRead.store(Read, std::memory_order_release);
+
+	if (DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(DeltaTime / MaxSubstepTime), 1, MaxSubsteps);
+	const float StepTime = DeltaTime / NumSubsteps;
+
+	for (int32 i = 0; i < NumSubsteps; ++i)
+	{
+		// semi-implicit euler
+		Velocity += (-Settings.Stiffness * Position - Settings.Damping * Velocity) * StepTime;
+		Position += Velocity * StepTime;
+
+		SlideVelocity += (-Settings.Stiffness * Slide - Settings.Damping * SlideVelocity) * StepTime;
+		Slide += SlideVelocity * StepTime;
+	}
+}
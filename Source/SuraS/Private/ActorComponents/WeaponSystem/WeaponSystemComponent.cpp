@@ -7,6 +7,7 @@
 #include "ActorComponents/WeaponSystem/SuraWeaponPickUp.h"
 #include "ActorComponents/WeaponSystem/ACWeapon.h"
 #include "ActorComponents/WeaponSystem/WeaponName.h"
+#include "SuraSStats.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -15,6 +16,8 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 
+DECLARE_CYCLE_STAT(TEXT("WeaponSystem SearchWeapon"), STAT_SuraWeaponSystemSearchWeapon, STATGROUP_SuraS);
+
 // Sets default values for this component's properties
 UWeaponSystemComponent::UWeaponSystemComponent()
 {
@@ -88,6 +91,8 @@ void UWeaponSystemComponent::InitializePlayerReference()
 #pragma region SearchWeapon
 bool UWeaponSystemComponent::SearchWeapon()
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraWeaponSystemSearchWeapon);
+
 	TArray<TEnumAsByte<EObjectTypeQuery>> traceObjectTypes;
 	traceObjectTypes.Add(UEngineTypes::ConvertToObjectType(ECollisionChannel::ECC_Visibility)); //TODO: Collision Channel �����ϱ�
 
@@ -98,6 +103,8 @@ bool UWeaponSystemComponent::SearchWeapon()
 
 	TArray<AActor*> overlappedActors;
 
+	SURAS_COUNT_TRACE();
+
 	bool bIsWeaponInViewPort = UKismetSystemLibrary::SphereOverlapActors(GetWorld(), sphereSpwanLocation, SearchWeaponRadius, traceObjectTypes, nullptr, ignoreActors, overlappedActors);
 
 	float MinDistanceToWeapon = SearchWeaponRadius;
@@ -2,61 +2,18 @@
 
 
 #include "Animations/ANS/ANS_MeleeAttack.h"
-#include "Components/CapsuleComponent.h"
-#include "Structures/DamageData.h"
-#include "Enumerations/EDamageType.h"
-#include "Characters/Player/SuraCharacterPlayer.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Characters/Enemies/Combat/EnemyMeleeHitResolver.h"
 
 void UANS_MeleeAttack::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EvetnRef)
 {
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EvetnRef);
 
-	Enemy = Cast<ASuraCharacterEnemyBase>(MeshComp->GetOwner());
-}
-
-void UANS_MeleeAttack::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EvetnRef)
-{
-	Super::NotifyTick(MeshComp, Animation, TotalDuration, EvetnRef);
-
-	if (Enemy && MeshComp)
+	// ANS cannot access GetWorld directly! Must be accessed through MeshComp or whoever has access to GetWorld function first
+	if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(MeshComp->GetOwner()))
 	{
-		FHitResult Hit;
-		FCollisionQueryParams CollisionQueryParams;
-		CollisionQueryParams.AddIgnoredActor(GetEnemyChar());
-
-		const FVector Start = GetEnemyChar()->GetActorLocation() + GetEnemyChar()->GetActorForwardVector() * GetEnemyChar()->GetCapsuleComponent()->GetScaledCapsuleRadius();
-		const FVector End = Start + GetEnemyChar()->GetActorForwardVector() * AttackRange;
-
-		// ANS cannot access GetWorld directly! Must be accessed through MeshComp or whoever has access to GetWorld function first
-		bool bHit = MeshComp->GetWorld()->SweepSingleByChannel(
-			Hit,
-			Start,
-			End,
-			FQuat::Identity,
-			ECollisionChannel::ECC_Pawn,
-			FCollisionShape::MakeSphere(AttackRadius),
-			CollisionQueryParams
-		);
-
-		if (bHit && bCanInflictDamage)
-		{
-			// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Yellow, TEXT("poyo"));
-
-			if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(Hit.GetActor()))
-			{
-
-				FDamageData DamageData;
-				DamageData.DamageAmount = Enemy->GetAttackDamageAmount() + AdditionalDamageAmount;
-				DamageData.DamageType = EDamageType::Melee;
-
-				Player->TakeDamage(DamageData, GetEnemyChar());
-
-				bCanInflictDamage = false;
-			}
-		}
-
-		// ANS cannot access GetWorld directly
-		// DrawDebugSphere(MeshComp->GetWorld(), Start + (End - Start) * 0.5f, AttackRadius, 24, Hit.bBlockingHit ? FColor::Blue : FColor::Red, false, 5.0f, 0, 10.0f);
+		if (UEnemyMeleeHitResolver* const MeleeHitResolver = MeshComp->GetWorld()->GetSubsystem<UEnemyMeleeHitResolver>())
+			MeleeHitResolver->OpenAttackWindow(this, Enemy, AttackRange, AttackRadius, AdditionalDamageAmount);
 	}
 }
 
@@ -64,5 +21,6 @@ void UANS_MeleeAttack::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequence
 {
 	Super::NotifyEnd(MeshComp, Animation, EvetnRef);
 
-	bCanInflictDamage = true;
+	if (UEnemyMeleeHitResolver* const MeleeHitResolver = MeshComp->GetWorld()->GetSubsystem<UEnemyMeleeHitResolver>())
+		MeleeHitResolver->CloseAttackWindow(this, MeshComp->GetOwner());
 }
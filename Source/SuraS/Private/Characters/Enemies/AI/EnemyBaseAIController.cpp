@@ -5,8 +5,13 @@
 #include "Characters/Player/SuraCharacterPlayer.h" // For detecting the player
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
+#include "Perception/AISense_Sight.h"
+#include "BrainComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "Structures/Enemies/EnemyAttributesData.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI OnTargetSighted"), STAT_SuraAIOnTargetSighted, STATGROUP_SuraS);
 
 AEnemyBaseAIController::AEnemyBaseAIController(FObjectInitializer const& ObjectInitializer)
 {
@@ -73,6 +78,8 @@ void AEnemyBaseAIController::SetupPerceptionSystem()
 
 void AEnemyBaseAIController::OnTargetSighted(AActor* SeenTarget, FAIStimulus const Stimulus)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAIOnTargetSighted);
+
 	if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(SeenTarget))
 	{
 		GetBlackboardComponent()->SetValueAsObject("AttackTarget", Player);
@@ -84,4 +91,23 @@ void AEnemyBaseAIController::UpdateCurrentState(EEnemyState NewState)
 {
 	CurrentState = NewState;
 	GetBlackboardComponent()->SetValueAsEnum("State", (uint8)NewState);
+}
+
+void AEnemyBaseAIController::ResumeState(EEnemyState State, AActor* AttackTarget)
+{
+	if (State == EEnemyState::Attacking && AttackTarget)
+		GetBlackboardComponent()->SetValueAsObject("AttackTarget", AttackTarget);
+	else
+		State = EEnemyState::Idle;
+
+	UpdateCurrentState(State);
+}
+
+void AEnemyBaseAIController::ApplyLODTierSettings(const FEnemyLODTierSettings& Settings)
+{
+	if (UBrainComponent* const Brain = GetBrainComponent())
+		Brain->SetComponentTickInterval(Settings.BehaviorTreeTickInterval);
+
+	if (UAIPerceptionComponent* const Perception = GetPerceptionComponent())
+		Perception->SetSenseEnabled(UAISense_Sight::StaticClass(), Settings.bEnablePerception);
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/Enemies/AI/EnemyNavQueryManager.h"
+#include "NavigationSystem.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("NavQuery ProcessRequests"), STAT_SuraNavQueryProcessRequests, STATGROUP_SuraS);
+
+bool UEnemyNavQueryManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyNavQueryManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (RandomLocationRequests.IsEmpty() && TargetLocationRequests.IsEmpty())
+		return;
+
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraNavQueryProcessRequests);
+
+	UNavigationSystemV1* const NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	ProcessRandomLocationRequests(NavSystem);
+	ProcessTargetLocationRequests(NavSystem);
+}
+
+TStatId UEnemyNavQueryManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyNavQueryManager, STATGROUP_Tickables);
+}
+
+uint32 UEnemyNavQueryManager::RequestRandomLocation(const FVector& Origin, float Radius, FOnNavQueryFinished OnFinished)
+{
+	const uint32 RequestId = ++LastRequestId;
+
+	RandomLocationRequests.Add({ RequestId, Origin, Radius, MoveTemp(OnFinished) });
+
+	return RequestId;
+}
+
+uint32 UEnemyNavQueryManager::RequestTargetLocation(const AActor* Target, FOnNavQueryFinished OnFinished)
+{
+	const uint32 RequestId = ++LastRequestId;
+
+	TargetLocationRequests.Add({ RequestId, Target, MoveTemp(OnFinished) });
+
+	return RequestId;
+}
+
+void UEnemyNavQueryManager::CancelRequest(uint32 RequestId)
+{
+	if (RequestId == 0)
+		return;
+
+	RandomLocationRequests.RemoveAll([RequestId](const FRandomLocationRequest& Request) { return Request.RequestId == RequestId; });
+	TargetLocationRequests.RemoveAll([RequestId](const FTargetLocationRequest& Request) { return Request.RequestId == RequestId; });
+}
+
+void UEnemyNavQueryManager::ProcessRandomLocationRequests(UNavigationSystemV1* NavSystem)
+{
+	const int32 NumQueries = FMath::Min(RandomLocationRequests.Num(), MaxRandomLocationQueriesPerTick);
+
+	if (NumQueries <= 0)
+		return;
+
+	// take the batch out first, the delegates may queue new requests
+	TArray<FRandomLocationRequest> Batch;
+	Batch.Reserve(NumQueries);
+
+	for (int32 i = 0; i < NumQueries; ++i)
+		Batch.Add(MoveTemp(RandomLocationRequests[i]));
+
+	RandomLocationRequests.RemoveAt(0, NumQueries, EAllowShrinking::No);
+
+	for (FRandomLocationRequest& Request : Batch)
+	{
+		FNavLocation RandomLocation;
+		const bool bSuccess = NavSystem && NavSystem->GetRandomPointInNavigableRadius(Request.Origin, Request.Radius, RandomLocation);
+
+		Request.OnFinished.ExecuteIfBound(bSuccess, RandomLocation.Location);
+	}
+}
+
+void UEnemyNavQueryManager::ProcessTargetLocationRequests(UNavigationSystemV1* NavSystem)
+{
+	if (TargetLocationRequests.IsEmpty())
+		return;
+
+	TArray<FTargetLocationRequest> Batch = MoveTemp(TargetLocationRequests);
+	TargetLocationRequests.Reset();
+
+	// every chaser of the same target in this batch gets the same answer from a single projection
+	for (FTargetLocationRequest& Request : Batch)
+	{
+		const AActor* const Target = Request.Target.Get();
+
+		if (!Target)
+		{
+			Request.OnFinished.ExecuteIfBound(false, FVector::ZeroVector);
+			continue;
+		}
+
+		const FSharedTargetLocation& SharedLocation = UpdateSharedTargetLocation(NavSystem, Target);
+
+		Request.OnFinished.ExecuteIfBound(SharedLocation.bIsValid, SharedLocation.Location);
+	}
+
+	for (auto It = SharedTargetLocations.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+			It.RemoveCurrent();
+	}
+}
+
+const UEnemyNavQueryManager::FSharedTargetLocation& UEnemyNavQueryManager::UpdateSharedTargetLocation(UNavigationSystemV1* NavSystem, const AActor* Target)
+{
+	FSharedTargetLocation& SharedLocation = SharedTargetLocations.FindOrAdd(Target);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (SharedLocation.bIsValid && CurrentTime - SharedLocation.LastUpdateTime < TargetRefreshInterval)
+		return SharedLocation;
+
+	SharedLocation.LastUpdateTime = CurrentTime;
+
+	const FVector TargetLocation = Target->GetActorLocation();
+
+	if (SharedLocation.bIsValid && FVector::DistSquared(SharedLocation.Location, TargetLocation) < FMath::Square(TargetMoveThreshold))
+		return SharedLocation;
+
+	// off the navmesh (e.g. jumping), chase the raw location rather than stopping
+	FNavLocation NavLocation;
+	const bool bProjected = NavSystem && NavSystem->ProjectPointToNavigation(TargetLocation, NavLocation);
+
+	SharedLocation.Location = bProjected ? NavLocation.Location : TargetLocation;
+	SharedLocation.bIsValid = true;
+
+	return SharedLocation;
+}
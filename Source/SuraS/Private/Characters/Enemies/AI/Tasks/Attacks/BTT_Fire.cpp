@@ -5,6 +5,7 @@
 #include "Characters/Player/SuraCharacterPlayer.h"
 #include "Characters/Enemies/SuraCharacterEnemyBase.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "SuraSStats.h"
 
 UBTT_Fire::UBTT_Fire(FObjectInitializer const& ObjectInitializer)
 {
@@ -13,6 +14,10 @@ UBTT_Fire::UBTT_Fire(FObjectInitializer const& ObjectInitializer)
 
 EBTNodeResult::Type UBTT_Fire::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTT_Fire);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(OwnerComp.GetAIOwner()->GetCharacter()))
 	{
 		if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("AttackTarget")))
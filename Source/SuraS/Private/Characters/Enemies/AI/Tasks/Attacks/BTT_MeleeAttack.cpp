@@ -6,6 +6,7 @@
 #include "Characters/Enemies/SuraCharacterEnemyBase.h"
 #include "Characters/Enemies/AI/EnemyBaseAIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "SuraSStats.h"
 
 UBTT_MeleeAttack::UBTT_MeleeAttack(FObjectInitializer const& ObjectInitializer)
 {
@@ -14,6 +15,10 @@ UBTT_MeleeAttack::UBTT_MeleeAttack(FObjectInitializer const& ObjectInitializer)
 
 EBTNodeResult::Type UBTT_MeleeAttack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTT_MeleeAttack);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(OwnerComp.GetAIOwner()->GetCharacter()))
 	{
 		if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("AttackTarget")))
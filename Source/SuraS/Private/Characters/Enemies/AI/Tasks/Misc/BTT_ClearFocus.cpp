@@ -3,6 +3,7 @@
 
 #include "Characters/Enemies/AI/Tasks/Misc/BTT_ClearFocus.h"
 #include "Characters/Enemies/AI/EnemyBaseAIController.h"
+#include "SuraSStats.h"
 
 UBTT_ClearFocus::UBTT_ClearFocus(FObjectInitializer const& ObjectInitializer)
 {
@@ -11,6 +12,10 @@ UBTT_ClearFocus::UBTT_ClearFocus(FObjectInitializer const& ObjectInitializer)
 
 EBTNodeResult::Type UBTT_ClearFocus::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTT_ClearFocus);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (AEnemyBaseAIController* const EnemyController = Cast<AEnemyBaseAIController>(OwnerComp.GetAIOwner()))
 	{
 		EnemyController->ClearFocus(EAIFocusPriority::Gameplay);
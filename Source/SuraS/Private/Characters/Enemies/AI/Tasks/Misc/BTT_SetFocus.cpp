@@ -5,6 +5,7 @@
 #include "Characters/Enemies/AI/EnemyBaseAIController.h"
 #include "Characters/Player/SuraCharacterPlayer.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "SuraSStats.h"
 
 UBTT_SetFocus::UBTT_SetFocus(FObjectInitializer const& ObjectInitializer)
 {
@@ -13,6 +14,10 @@ UBTT_SetFocus::UBTT_SetFocus(FObjectInitializer const& ObjectInitializer)
 
 EBTNodeResult::Type UBTT_SetFocus::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTT_SetFocus);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (AEnemyBaseAIController* const EnemyController = Cast<AEnemyBaseAIController>(OwnerComp.GetAIOwner()))
 	{
 		if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("AttackTarget")))
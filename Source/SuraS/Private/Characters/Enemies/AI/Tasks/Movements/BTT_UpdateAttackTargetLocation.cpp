@@ -1,8 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Characters/Enemies/AI/Tasks/Movements/BTT_UpdateAttackTargetLocation.h"
+#include "Characters/Enemies/AI/EnemyNavQueryManager.h"
 #include "Characters/Player/SuraCharacterPlayer.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "SuraSStats.h"
 
 UBTT_UpdateAttackTargetLocation::UBTT_UpdateAttackTargetLocation(FObjectInitializer const& ObjectInitializer)
 {
@@ -11,13 +13,53 @@ UBTT_UpdateAttackTargetLocation::UBTT_UpdateAttackTargetLocation(FObjectInitiali
 
 EBTNodeResult::Type UBTT_UpdateAttackTargetLocation::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTT_UpdateAttackTargetLocation);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(OwnerComp.GetBlackboardComponent()->GetValueAsObject("AttackTarget")))
 	{
-		OwnerComp.GetBlackboardComponent()->SetValueAsVector("TargetLocation", Player->GetActorLocation());
+		if (UEnemyNavQueryManager* const NavQueryManager = GetWorld()->GetSubsystem<UEnemyNavQueryManager>())
+		{
+			// the location is shared by every chaser and only moves once the player really moved,
+			// so the blackboard value (and the move task observing it) doesn't change every frame
+			CastInstanceNodeMemory<FBTNavQueryTaskMemory>(NodeMemory)->RequestId = NavQueryManager->RequestTargetLocation(
+				Player,
+				FOnNavQueryFinished::CreateUObject(this, &UBTT_UpdateAttackTargetLocation::OnQueryFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp))
+			);
 
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-		return EBTNodeResult::Succeeded;
+			return EBTNodeResult::InProgress;
+		}
 	}
 
 	return EBTNodeResult::Failed;
 }
+
+EBTNodeResult::Type UBTT_UpdateAttackTargetLocation::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (UEnemyNavQueryManager* const NavQueryManager = GetWorld()->GetSubsystem<UEnemyNavQueryManager>())
+		NavQueryManager->CancelRequest(CastInstanceNodeMemory<FBTNavQueryTaskMemory>(NodeMemory)->RequestId);
+
+	return EBTNodeResult::Aborted;
+}
+
+uint16 UBTT_UpdateAttackTargetLocation::GetInstanceMemorySize() const
+{
+	return sizeof(FBTNavQueryTaskMemory);
+}
+
+void UBTT_UpdateAttackTargetLocation::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTNavQueryTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTT_UpdateAttackTargetLocation::OnQueryFinished(bool bSuccess, const FVector& Location, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+		return;
+
+	if (bSuccess)
+		OwnerComp->GetBlackboardComponent()->SetValueAsVector("TargetLocation", Location);
+
+	FinishLatentTask(*OwnerComp, bSuccess ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
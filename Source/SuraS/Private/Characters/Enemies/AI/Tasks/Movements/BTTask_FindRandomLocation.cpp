@@ -2,8 +2,9 @@
 
 #include "Characters/Enemies/AI/Tasks/Movements/BTTask_FindRandomLocation.h"
 #include "Characters/Enemies/AI/EnemyBaseAIController.h"
-#include "NavigationSystem.h"
+#include "Characters/Enemies/AI/EnemyNavQueryManager.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "SuraSStats.h"
 
 UBTTask_FindRandomLocation::UBTTask_FindRandomLocation(FObjectInitializer const& ObjectInitializer)
 {
@@ -12,25 +13,57 @@ UBTTask_FindRandomLocation::UBTTask_FindRandomLocation(FObjectInitializer const&
 
 EBTNodeResult::Type UBTTask_FindRandomLocation::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraAITaskExecute);
+	SURAS_TRACE_SCOPE(BTTask_FindRandomLocation);
+	INC_DWORD_STAT(STAT_SuraAITaskExecutions);
+
 	if (AEnemyBaseAIController* const EnemyController = Cast<AEnemyBaseAIController>(OwnerComp.GetAIOwner()))
 	{
 		if (auto* const Enemy = EnemyController->GetPawn())
 		{
-			if (UNavigationSystemV1* const Navigation = UNavigationSystemV1::GetCurrent(GetWorld()))
+			if (UEnemyNavQueryManager* const NavQueryManager = GetWorld()->GetSubsystem<UEnemyNavQueryManager>())
 			{
 				FVector const Origin = Enemy->GetActorLocation();
-				FNavLocation RandomLocation;
 
-				if (Navigation->GetRandomPointInNavigableRadius(Origin, SearchRadius, RandomLocation))
-				{
-					OwnerComp.GetBlackboardComponent()->SetValueAsVector("TargetLocation", RandomLocation);
+				CastInstanceNodeMemory<FBTNavQueryTaskMemory>(NodeMemory)->RequestId = NavQueryManager->RequestRandomLocation(
+					Origin,
+					SearchRadius,
+					FOnNavQueryFinished::CreateUObject(this, &UBTTask_FindRandomLocation::OnQueryFinished, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp))
+				);
 
-					FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-					return EBTNodeResult::Succeeded;
-				}
+				return EBTNodeResult::InProgress;
 			}
 		}
 	}
 
 	return EBTNodeResult::Failed;
 }
+
+EBTNodeResult::Type UBTTask_FindRandomLocation::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (UEnemyNavQueryManager* const NavQueryManager = GetWorld()->GetSubsystem<UEnemyNavQueryManager>())
+		NavQueryManager->CancelRequest(CastInstanceNodeMemory<FBTNavQueryTaskMemory>(NodeMemory)->RequestId);
+
+	return EBTNodeResult::Aborted;
+}
+
+uint16 UBTTask_FindRandomLocation::GetInstanceMemorySize() const
+{
+	return sizeof(FBTNavQueryTaskMemory);
+}
+
+void UBTTask_FindRandomLocation::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTNavQueryTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_FindRandomLocation::OnQueryFinished(bool bSuccess, const FVector& Location, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+		return;
+
+	if (bSuccess)
+		OwnerComp->GetBlackboardComponent()->SetValueAsVector("TargetLocation", Location);
+
+	FinishLatentTask(*OwnerComp, bSuccess ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/Enemies/Combat/EnemyMeleeHitResolver.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Characters/Player/SuraCharacterPlayer.h"
+#include "Components/CapsuleComponent.h"
+#include "Structures/DamageData.h"
+#include "Enumerations/EDamageType.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("MeleeHit EvaluateWindows"), STAT_SuraMeleeEvaluateWindows, STATGROUP_SuraS);
+
+bool UEnemyMeleeHitResolver::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyMeleeHitResolver::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastEvaluation += DeltaTime;
+
+	if (TimeSinceLastEvaluation >= EvaluationInterval)
+	{
+		TimeSinceLastEvaluation = 0.f;
+		EvaluateWindows();
+	}
+}
+
+TStatId UEnemyMeleeHitResolver::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyMeleeHitResolver, STATGROUP_Tickables);
+}
+
+void UEnemyMeleeHitResolver::OpenAttackWindow(const UObject* Source, ASuraCharacterEnemyBase* Enemy, float AttackRange, float AttackRadius, float AdditionalDamageAmount)
+{
+	if (!Enemy)
+		return;
+
+	FMeleeAttackWindow Window;
+	Window.Source = Source;
+	Window.Enemy = Enemy;
+	Window.AttackRange = AttackRange;
+	Window.AttackRadius = AttackRadius;
+	Window.AdditionalDamageAmount = AdditionalDamageAmount;
+
+	FScopeLock Lock(&WindowsLock);
+	Windows.Add(Window);
+}
+
+void UEnemyMeleeHitResolver::CloseAttackWindow(const UObject* Source, const AActor* Enemy)
+{
+	FScopeLock Lock(&WindowsLock);
+
+	for (FMeleeAttackWindow& Window : Windows)
+	{
+		if (!Window.bIsClosed && Window.Source == Source && Window.Enemy.Get() == Enemy)
+		{
+			Window.bIsClosed = true;
+			break;
+		}
+	}
+}
+
+void UEnemyMeleeHitResolver::RemoveAttackWindows(const AActor* Enemy)
+{
+	FScopeLock Lock(&WindowsLock);
+
+	Windows.RemoveAllSwap([Enemy](const FMeleeAttackWindow& Window) { return Window.Enemy.Get() == Enemy; });
+}
+
+void UEnemyMeleeHitResolver::EvaluateWindows()
+{
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraMeleeEvaluateWindows);
+
+	ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(GetWorld()->GetFirstPlayerController() ? GetWorld()->GetFirstPlayerController()->GetPawn() : nullptr);
+
+	// [enemy, damage amount] applied once the lock is released, since taking damage fires gameplay events
+	TArray<TPair<ASuraCharacterEnemyBase*, float>> Hits;
+
+	{
+		FScopeLock Lock(&WindowsLock);
+
+		if (Windows.IsEmpty())
+			return;
+
+		FVector CapsuleBottom = FVector::ZeroVector;
+		FVector CapsuleTop = FVector::ZeroVector;
+		float CapsuleRadius = 0.f;
+
+		if (Player)
+		{
+			const UCapsuleComponent* const Capsule = Player->GetCapsuleComponent();
+			const FVector CapsuleAxis = Capsule->GetUpVector() * Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+
+			CapsuleBottom = Capsule->GetComponentLocation() - CapsuleAxis;
+			CapsuleTop = Capsule->GetComponentLocation() + CapsuleAxis;
+			CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+		}
+
+		for (FMeleeAttackWindow& Window : Windows)
+		{
+			Window.bHasBeenEvaluated = true;
+
+			ASuraCharacterEnemyBase* const Enemy = Window.Enemy.Get();
+
+			if (!Player || !Enemy || Window.bHasHit || Enemy->IsDead())
+				continue;
+
+			// same volume the old per-tick sweep covered: a sphere swept forward from the front of the capsule
+			const FVector Forward = Enemy->GetActorForwardVector();
+			const FVector Start = Enemy->GetActorLocation() + Forward * Enemy->GetCapsuleComponent()->GetScaledCapsuleRadius();
+			const FVector End = Start + Forward * Window.AttackRange;
+
+			FVector ClosestOnAttack;
+			FVector ClosestOnCapsule;
+			FMath::SegmentDistToSegmentSafe(Start, End, CapsuleBottom, CapsuleTop, ClosestOnAttack, ClosestOnCapsule);
+
+			if (FVector::DistSquared(ClosestOnAttack, ClosestOnCapsule) <= FMath::Square(Window.AttackRadius + CapsuleRadius))
+			{
+				Window.bHasHit = true;
+				Hits.Emplace(Enemy, Enemy->GetAttackDamageAmount() + Window.AdditionalDamageAmount);
+			}
+		}
+
+		Windows.RemoveAllSwap([](const FMeleeAttackWindow& Window) { return !Window.Enemy.IsValid() || (Window.bIsClosed && Window.bHasBeenEvaluated); });
+	}
+
+	for (const TPair<ASuraCharacterEnemyBase*, float>& Hit : Hits)
+	{
+		FDamageData DamageData;
+		DamageData.DamageAmount = Hit.Value;
+		DamageData.DamageType = EDamageType::Melee;
+		DamageData.bCanForceDamage = false;
+
+		Player->TakeDamage(DamageData, Hit.Key);
+	}
+}
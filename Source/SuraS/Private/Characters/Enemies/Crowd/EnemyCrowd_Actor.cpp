@@ -0,0 +1,403 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/Enemies/Crowd/EnemyCrowd_Actor.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "NavigationSystem.h"
+
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Characters/Enemies/Spawner/ObjectPool_Actor.h"
+#include "Structures/Enemies/EnemyAttributesData.h"
+#include "SuraSStats.h"
+
+// hydrated and dead entities keep their instance, parked out of sight below the crowd
+static const FVector ParkedInstanceOffset(0.f, 0.f, -100000.f);
+
+AEnemyCrowd_Actor::AEnemyCrowd_Actor()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void AEnemyCrowd_Actor::BeginPlay()
+{
+	LLM_SCOPE_BYTAG(SuraS_Enemies);
+
+	Super::BeginPlay();
+
+	for (const FEnemyCrowdType& CrowdType : CrowdTypes)
+	{
+		UInstancedStaticMeshComponent* const InstanceComp = NewObject<UInstancedStaticMeshComponent>(this);
+
+		InstanceComp->SetupAttachment(RootComponent);
+		InstanceComp->SetMobility(EComponentMobility::Movable);
+		InstanceComp->SetStaticMesh(CrowdType.Mesh);
+		InstanceComp->SetCastShadow(false);
+		InstanceComp->SetCanEverAffectNavigation(false);
+
+		if (bInstancesBlockProjectiles)
+		{
+			InstanceComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			InstanceComp->SetCollisionObjectType(ECC_WorldDynamic);
+			InstanceComp->SetCollisionResponseToAllChannels(ECR_Ignore);
+			InstanceComp->SetCollisionResponseToChannel(ECC_GameTraceChannel1, ECR_Block); // SuraProjectile object
+			InstanceComp->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+			InstanceComp->OnComponentHit.AddDynamic(this, &AEnemyCrowd_Actor::OnInstanceHit);
+		}
+		else
+		{
+			InstanceComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
+
+		InstanceComp->RegisterComponent();
+
+		InstanceComps.Add(InstanceComp);
+		InstanceToEntity.AddDefaulted();
+		InstanceTransforms.AddDefaulted();
+	}
+
+	SpawnEntities();
+}
+
+void AEnemyCrowd_Actor::SpawnEntities()
+{
+	UNavigationSystemV1* const NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	for (int32 TypeIndex = 0; TypeIndex < CrowdTypes.Num(); ++TypeIndex)
+	{
+		const FEnemyCrowdType& CrowdType = CrowdTypes[TypeIndex];
+
+		if (!CrowdType.Pool || !CrowdType.Pool->PooledObjectSubclass)
+			continue;
+
+		float Health = 100.f;
+		float Speed = 300.f;
+
+		// the crowd uses the same attributes as the full character it hydrates into
+		if (const ASuraCharacterEnemyBase* const EnemyCDO = Cast<ASuraCharacterEnemyBase>(CrowdType.Pool->PooledObjectSubclass->GetDefaultObject()))
+		{
+			if (EnemyCDO->EnemyAttributesDT.DataTable)
+			{
+				if (const FEnemyAttributesData* const EnemyAttributesData = EnemyCDO->EnemyAttributesDT.DataTable->FindRow<FEnemyAttributesData>(EnemyCDO->GetEnemyType(), ""))
+				{
+					Health = EnemyAttributesData->MaxHealth;
+					Speed = EnemyAttributesData->MaxWalkSpeed;
+				}
+			}
+		}
+
+		Entities.Reserve(Entities.Num() + CrowdType.Count);
+		InstanceToEntity[TypeIndex].Reserve(CrowdType.Count);
+		InstanceTransforms[TypeIndex].Reserve(CrowdType.Count);
+
+		for (int32 InstanceIndex = 0; InstanceIndex < CrowdType.Count; ++InstanceIndex)
+		{
+			FEnemyCrowdEntity Entity;
+			Entity.Location = GetActorLocation();
+
+			FNavLocation NavLocation;
+			if (NavSystem && NavSystem->GetRandomPointInNavigableRadius(GetActorLocation(), SpawnRadius, NavLocation))
+				Entity.Location = NavLocation.Location;
+
+			Entity.NavLocation = Entity.Location;
+			Entity.Goal = Entity.Location;
+			Entity.Speed = Speed;
+			Entity.Health = Health;
+			Entity.TypeIndex = TypeIndex;
+			Entity.InstanceIndex = InstanceIndex;
+
+			InstanceToEntity[TypeIndex].Add(Entities.Add(Entity));
+			InstanceTransforms[TypeIndex].Add(FTransform(Entity.Location));
+		}
+
+		InstanceComps[TypeIndex]->AddInstances(InstanceTransforms[TypeIndex], false, true, false);
+	}
+}
+
+void AEnemyCrowd_Actor::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	// damage that never got matched with an instance hit (e.g. splash) is dropped
+	PendingDamage.Reset();
+	PendingDamageCauser = nullptr;
+
+	const APawn* const Player = UGameplayStatics::GetPlayerPawn(this, 0);
+
+	if (!Player)
+		return;
+
+	const FVector PlayerLocation = Player->GetActorLocation();
+
+	UpdateHydration(PlayerLocation);
+	UpdateMovement(DeltaSeconds, PlayerLocation);
+	UpdateNavigation();
+	UpdateInstances();
+}
+
+void AEnemyCrowd_Actor::UpdateMovement(float DeltaSeconds, const FVector& PlayerLocation)
+{
+	const float ChaseDistanceSquared = FMath::Square(ChaseDistance);
+	const float AcceptanceRadiusSquared = FMath::Square(AcceptanceRadius);
+
+	for (FEnemyCrowdEntity& Entity : Entities)
+	{
+		if (Entity.IsDead() || Entity.IsHydrated())
+			continue;
+
+		if (FVector::DistSquared2D(Entity.Location, PlayerLocation) < ChaseDistanceSquared)
+		{
+			Entity.Goal = PlayerLocation;
+			Entity.State = EEnemyState::Attacking;
+		}
+		else if (Entity.State == EEnemyState::Attacking)
+		{
+			Entity.State = EEnemyState::Idle;
+			Entity.bNeedsNewGoal = true;
+		}
+
+		const FVector ToGoal = Entity.Goal - Entity.Location;
+
+		if (ToGoal.SizeSquared2D() <= AcceptanceRadiusSquared)
+		{
+			Entity.Velocity = FVector::ZeroVector;
+
+			if (Entity.State != EEnemyState::Attacking)
+				Entity.bNeedsNewGoal = true;
+
+			continue;
+		}
+
+		Entity.Velocity = ToGoal.GetSafeNormal2D() * Entity.Speed;
+		Entity.Location += Entity.Velocity * DeltaSeconds;
+	}
+}
+
+void AEnemyCrowd_Actor::UpdateNavigation()
+{
+	UNavigationSystemV1* const NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	if (!NavSystem || Entities.IsEmpty())
+		return;
+
+	int32 NumQueries = 0;
+
+	// round robin over the crowd, so the cost stays the same however many entities there are
+	for (int32 NumVisited = 0; NumVisited < Entities.Num() && NumQueries < MaxNavQueriesPerTick; ++NumVisited)
+	{
+		NavQueryCursor = (NavQueryCursor + 1) % Entities.Num();
+
+		FEnemyCrowdEntity& Entity = Entities[NavQueryCursor];
+
+		if (Entity.IsDead() || Entity.IsHydrated())
+			continue;
+
+		FNavLocation NavLocation;
+
+		// keep the entity on the navmesh, walking off it puts it back on the last valid spot
+		++NumQueries;
+		if (NavSystem->ProjectPointToNavigation(Entity.Location, NavLocation))
+		{
+			Entity.Location = NavLocation.Location;
+			Entity.NavLocation = NavLocation.Location;
+		}
+		else
+		{
+			Entity.Location = Entity.NavLocation;
+			Entity.bNeedsNewGoal = true;
+		}
+
+		if (Entity.bNeedsNewGoal && Entity.State != EEnemyState::Attacking)
+		{
+			++NumQueries;
+			if (NavSystem->GetRandomReachablePointInRadius(Entity.Location, RoamRadius, NavLocation))
+			{
+				Entity.Goal = NavLocation.Location;
+				Entity.bNeedsNewGoal = false;
+			}
+		}
+	}
+}
+
+void AEnemyCrowd_Actor::UpdateHydration(const FVector& PlayerLocation)
+{
+	const float DehydrateDistanceSquared = FMath::Square(DehydrateDistance);
+
+	for (int32 i = HydratedEntityIndices.Num() - 1; i >= 0; --i)
+	{
+		const int32 EntityIndex = HydratedEntityIndices[i];
+		FEnemyCrowdEntity& Entity = Entities[EntityIndex];
+
+		if (!IsValid(Entity.HydratedEnemy) || Entity.HydratedEnemy->IsDead())
+		{
+			// the dead character stays with its pool, which reuses it once the death timer hides it
+			Entity.Health = 0.f;
+			Entity.State = EEnemyState::Dead;
+			Entity.HydratedEnemy = nullptr;
+
+			HydratedEntityIndices.RemoveAtSwap(i);
+		}
+		else if (FVector::DistSquared(Entity.HydratedEnemy->GetActorLocation(), PlayerLocation) > DehydrateDistanceSquared)
+		{
+			DehydrateEntity(EntityIndex);
+		}
+	}
+
+	const float HydrateDistanceSquared = FMath::Square(HydrateDistance);
+	int32 NumHydrations = 0;
+
+	for (int32 EntityIndex = 0; EntityIndex < Entities.Num(); ++EntityIndex)
+	{
+		if (NumHydrations >= MaxHydrationsPerTick || HydratedEntityIndices.Num() >= MaxHydratedEntities)
+			break;
+
+		const FEnemyCrowdEntity& Entity = Entities[EntityIndex];
+
+		if (Entity.IsDead() || Entity.IsHydrated())
+			continue;
+
+		if (FVector::DistSquared(Entity.Location, PlayerLocation) < HydrateDistanceSquared && HydrateEntity(EntityIndex))
+			++NumHydrations;
+	}
+}
+
+void AEnemyCrowd_Actor::UpdateInstances()
+{
+	for (int32 TypeIndex = 0; TypeIndex < InstanceComps.Num(); ++TypeIndex)
+	{
+		TArray<FTransform>& Transforms = InstanceTransforms[TypeIndex];
+
+		if (Transforms.IsEmpty())
+			continue;
+
+		const TArray<int32>& EntityIndices = InstanceToEntity[TypeIndex];
+		UInstancedStaticMeshComponent* const InstanceComp = InstanceComps[TypeIndex];
+		bool bAnyMoved = false;
+
+		for (int32 InstanceIndex = 0; InstanceIndex < Transforms.Num(); ++InstanceIndex)
+		{
+			const FEnemyCrowdEntity& Entity = Entities[EntityIndices[InstanceIndex]];
+			FTransform& Transform = Transforms[InstanceIndex];
+			const FVector OldLocation = Transform.GetLocation();
+			const FQuat OldRotation = Transform.GetRotation();
+
+			if (Entity.IsDead() || Entity.IsHydrated())
+			{
+				Transform.SetLocation(GetActorLocation() + ParkedInstanceOffset);
+			}
+			else
+			{
+				Transform.SetLocation(Entity.Location);
+
+				if (!Entity.Velocity.IsNearlyZero())
+					Transform.SetRotation(Entity.Velocity.ToOrientationQuat());
+			}
+
+			if (!Transform.GetLocation().Equals(OldLocation) || !Transform.GetRotation().Equals(OldRotation))
+				bAnyMoved = true;
+		}
+
+		// a type whose instances are all parked or idle is left alone, otherwise every instance goes in one batch
+		if (bAnyMoved)
+			InstanceComp->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+	}
+}
+
+bool AEnemyCrowd_Actor::HydrateEntity(int32 EntityIndex)
+{
+	FEnemyCrowdEntity& Entity = Entities[EntityIndex];
+	AObjectPool_Actor* const Pool = CrowdTypes[Entity.TypeIndex].Pool;
+
+	if (!Pool)
+		return false;
+
+	// entities live on the navmesh, characters are placed by the center of their capsule
+	float CapsuleHalfHeight = 0.f;
+
+	if (const ACharacter* const CharacterCDO = Cast<ACharacter>(Pool->PooledObjectSubclass->GetDefaultObject()))
+		CapsuleHalfHeight = CharacterCDO->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	const FRotator Rotation = Entity.Velocity.IsNearlyZero() ? FRotator::ZeroRotator : Entity.Velocity.Rotation();
+
+	APawn* const Pawn = Pool->AcquirePooledObject(Entity.Location + FVector(0.f, 0.f, CapsuleHalfHeight), Rotation);
+	ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(Pawn);
+
+	if (!Enemy)
+	{
+		Pool->ReleasePooledObject(Pawn);
+		return false;
+	}
+
+	Enemy->RestoreHealth(Entity.Health);
+
+	if (AEnemyBaseAIController* const EnemyAIController = Enemy->GetAIController())
+		EnemyAIController->ResumeState(Entity.State, UGameplayStatics::GetPlayerPawn(this, 0));
+
+	Entity.HydratedEnemy = Enemy;
+	HydratedEntityIndices.Add(EntityIndex);
+
+	return true;
+}
+
+void AEnemyCrowd_Actor::DehydrateEntity(int32 EntityIndex)
+{
+	FEnemyCrowdEntity& Entity = Entities[EntityIndex];
+	ASuraCharacterEnemyBase* const Enemy = Entity.HydratedEnemy;
+
+	Entity.Location = Enemy->GetActorLocation() - FVector(0.f, 0.f, Enemy->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+	Entity.NavLocation = Entity.Location;
+	Entity.Velocity = Enemy->GetVelocity();
+	Entity.Health = Enemy->GetDamageSystemComp()->GetHealth();
+	Entity.bNeedsNewGoal = true;
+
+	if (AEnemyBaseAIController* const EnemyAIController = Enemy->GetAIController())
+		Entity.State = EnemyAIController->GetCurrentState();
+
+	Entity.HydratedEnemy = nullptr;
+	HydratedEntityIndices.RemoveSingleSwap(EntityIndex);
+
+	CrowdTypes[Entity.TypeIndex].Pool->ReleasePooledObject(Enemy);
+}
+
+bool AEnemyCrowd_Actor::TakeDamage(const FDamageData& DamageData, const AActor* DamageCauser)
+{
+	// IDamageable doesn't tell which instance was hit, the instance hit event that follows does
+	PendingDamage.Add(DamageData);
+	PendingDamageCauser = DamageCauser;
+
+	return true;
+}
+
+void AEnemyCrowd_Actor::OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	const int32 TypeIndex = InstanceComps.IndexOfByKey(HitComponent);
+
+	// the hit is reversed for this side, so our instance is in MyItem
+	if (TypeIndex == INDEX_NONE || !InstanceToEntity[TypeIndex].IsValidIndex(Hit.MyItem))
+		return;
+
+	const int32 EntityIndex = InstanceToEntity[TypeIndex][Hit.MyItem];
+	FEnemyCrowdEntity& Entity = Entities[EntityIndex];
+
+	if (!Entity.IsDead() && !Entity.IsHydrated())
+	{
+		// getting shot always hydrates, even past the budget, so hit reactions play on a real character
+		if (HydrateEntity(EntityIndex))
+		{
+			for (const FDamageData& DamageData : PendingDamage)
+				Entity.HydratedEnemy->TakeDamage(DamageData, PendingDamageCauser);
+		}
+		else
+		{
+			for (const FDamageData& DamageData : PendingDamage)
+				Entity.Health -= DamageData.DamageAmount;
+		}
+	}
+
+	PendingDamage.Reset();
+	PendingDamageCauser = nullptr;
+}
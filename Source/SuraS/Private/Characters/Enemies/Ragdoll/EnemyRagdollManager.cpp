@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/Enemies/Ragdoll/EnemyRagdollManager.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll UpdateRagdolls"), STAT_SuraUpdateRagdolls, STATGROUP_SuraS);
+
+bool UEnemyRagdollManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyRagdollManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+
+	if (TimeSinceLastUpdate >= UpdateInterval)
+	{
+		TimeSinceLastUpdate = 0.f;
+		UpdateRagdolls();
+	}
+}
+
+TStatId UEnemyRagdollManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyRagdollManager, STATGROUP_Tickables);
+}
+
+bool UEnemyRagdollManager::RequestRagdoll(ASuraCharacterEnemyBase* Enemy)
+{
+	if (!Enemy)
+		return false;
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	if (ActiveRagdolls.Num() >= MaxSimulatingRagdolls)
+	{
+		// make room by freezing the oldest ragdoll, unless it only just started falling
+		if (ActiveRagdolls.IsEmpty() || CurrentTime - ActiveRagdolls[0].StartTime < MinSimulationTime)
+			return false;
+
+		ASuraCharacterEnemyBase* const OldestEnemy = ActiveRagdolls[0].Enemy.Get();
+		ActiveRagdolls.RemoveAt(0);
+
+		if (OldestEnemy)
+			FreezeRagdoll(OldestEnemy);
+	}
+
+	USkeletalMeshComponent* const Mesh = Enemy->GetMesh();
+
+	Mesh->SetCollisionProfileName(TEXT("Ragdoll"));
+	Mesh->SetSimulatePhysics(true);
+	Mesh->SetCollisionObjectType(ECC_GameTraceChannel1); // to disable collision with SuraProjectile object
+
+	FActiveRagdoll Ragdoll;
+	Ragdoll.Enemy = Enemy;
+	Ragdoll.StartTime = CurrentTime;
+
+	ActiveRagdolls.Add(Ragdoll);
+
+	return true;
+}
+
+void UEnemyRagdollManager::ReleaseRagdoll(ASuraCharacterEnemyBase* Enemy)
+{
+	if (!Enemy)
+		return;
+
+	ActiveRagdolls.RemoveAll([Enemy](const FActiveRagdoll& Ragdoll) { return Ragdoll.Enemy.Get() == Enemy; });
+
+	USkeletalMeshComponent* const Mesh = Enemy->GetMesh();
+
+	Mesh->SetSimulatePhysics(false);
+	Mesh->bNoSkeletonUpdate = false;
+	Mesh->SetComponentTickEnabled(true);
+}
+
+void UEnemyRagdollManager::UpdateRagdolls()
+{
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraUpdateRagdolls);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = 0; i < ActiveRagdolls.Num();)
+	{
+		FActiveRagdoll& Ragdoll = ActiveRagdolls[i];
+		ASuraCharacterEnemyBase* const Enemy = Ragdoll.Enemy.Get();
+
+		if (!Enemy)
+		{
+			ActiveRagdolls.RemoveAt(i);
+			continue;
+		}
+
+		USkeletalMeshComponent* const Mesh = Enemy->GetMesh();
+
+		const bool bSleptLongEnough = Ragdoll.SleepTime >= 0.f && CurrentTime - Ragdoll.SleepTime >= SleepToFreezeDelay;
+
+		if (bSleptLongEnough || CurrentTime - Ragdoll.StartTime >= MaxSimulationTime)
+		{
+			FreezeRagdoll(Enemy);
+			ActiveRagdolls.RemoveAt(i);
+			continue;
+		}
+
+		if (Ragdoll.SleepTime < 0.f && Mesh->GetPhysicsLinearVelocity().SizeSquared() < FMath::Square(SettledSpeed))
+		{
+			Mesh->PutAllRigidBodiesToSleep();
+			Ragdoll.SleepTime = CurrentTime;
+		}
+
+		++i;
+	}
+}
+
+void UEnemyRagdollManager::FreezeRagdoll(ASuraCharacterEnemyBase* Enemy)
+{
+	USkeletalMeshComponent* const Mesh = Enemy->GetMesh();
+
+	// the last simulated pose stays on screen as long as the skeleton isn't updated again
+	Mesh->bNoSkeletonUpdate = true;
+	Mesh->SetSimulatePhysics(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Mesh->SetComponentTickEnabled(false);
+}
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/Enemies/Significance/EnemySignificanceManager.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Characters/Enemies/AI/EnemyBaseAIController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance UpdateSignificance"), STAT_SuraUpdateSignificance, STATGROUP_SuraS);
+
+bool UEnemySignificanceManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemySignificanceManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeSinceLastUpdate += DeltaTime;
+
+	if (TimeSinceLastUpdate >= UpdateInterval)
+	{
+		TimeSinceLastUpdate = 0.f;
+		UpdateSignificance();
+	}
+}
+
+TStatId UEnemySignificanceManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceManager, STATGROUP_Tickables);
+}
+
+void UEnemySignificanceManager::RegisterEnemy(ASuraCharacterEnemyBase* Enemy)
+{
+	if (Enemy)
+	{
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+void UEnemySignificanceManager::UnregisterEnemy(ASuraCharacterEnemyBase* Enemy)
+{
+	Enemies.RemoveSwap(Enemy);
+}
+
+void UEnemySignificanceManager::UpdateSignificance()
+{
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraUpdateSignificance);
+
+	APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+		return;
+
+	const FVector ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+
+	Enemies.RemoveAllSwap([](const ASuraCharacterEnemyBase* Enemy) { return !IsValid(Enemy); });
+
+	// [weighted distance, enemy] sorted so that the most significant enemies come first
+	TArray<TPair<float, ASuraCharacterEnemyBase*>> RankedEnemies;
+	RankedEnemies.Reserve(Enemies.Num());
+
+	for (ASuraCharacterEnemyBase* const Enemy : Enemies)
+	{
+		RankedEnemies.Emplace(CalculateWeightedDistance(Enemy, ViewLocation), Enemy);
+	}
+
+	RankedEnemies.Sort([](const TPair<float, ASuraCharacterEnemyBase*>& A, const TPair<float, ASuraCharacterEnemyBase*>& B) { return A.Key < B.Key; });
+
+	int32 NumHighTierEnemies = 0;
+
+	for (const TPair<float, ASuraCharacterEnemyBase*>& RankedEnemy : RankedEnemies)
+	{
+		ASuraCharacterEnemyBase* const Enemy = RankedEnemy.Value;
+
+		// a dying enemy keeps its tier so the death montage animates at the rate it was seen at, until ReturnToPool hides it
+		if (Enemy->IsDead() && !Enemy->IsHidden())
+			continue;
+
+		EEnemyLODTier NewTier = EEnemyLODTier::Dormant;
+
+		// pooled (hidden) enemies don't need anything but the cheapest tier
+		if (!Enemy->IsHidden())
+		{
+			NewTier = CalculateTier(RankedEnemy.Key, Enemy->GetLODTier());
+
+			if (NewTier == EEnemyLODTier::High && ++NumHighTierEnemies > MaxHighTierEnemies)
+				NewTier = EEnemyLODTier::Medium;
+		}
+
+		Enemy->ApplyLODTier(NewTier);
+	}
+}
+
+float UEnemySignificanceManager::CalculateWeightedDistance(const ASuraCharacterEnemyBase* Enemy, const FVector& ViewLocation) const
+{
+	float Distance = FVector::Dist(ViewLocation, Enemy->GetActorLocation());
+
+	if (!Enemy->WasRecentlyRendered(0.2f))
+		Distance *= NotRenderedDistanceScale;
+
+	if (Enemy->GetAIController() && Enemy->GetAIController()->GetCurrentState() == EEnemyState::Attacking)
+		Distance *= AttackingDistanceScale;
+
+	return Distance;
+}
+
+EEnemyLODTier UEnemySignificanceManager::CalculateTier(float WeightedDistance, EEnemyLODTier CurrentTier) const
+{
+	// tier reached when every boundary is pushed out by the hysteresis margin
+	EEnemyLODTier FarTier = EEnemyLODTier::High;
+	// tier reached with the raw boundaries
+	EEnemyLODTier NearTier = EEnemyLODTier::High;
+
+	for (const EEnemyLODTier Tier : { EEnemyLODTier::Medium, EEnemyLODTier::Low, EEnemyLODTier::Dormant })
+	{
+		const float Boundary = GetTierBoundary(Tier);
+
+		if (WeightedDistance >= Boundary * (1.f + HysteresisRatio))
+			FarTier = Tier;
+
+		if (WeightedDistance >= Boundary)
+			NearTier = Tier;
+	}
+
+	// only move away once clearly past the boundary, move closer as soon as the boundary is crossed
+	if (FarTier > CurrentTier)
+		return FarTier;
+
+	if (NearTier < CurrentTier)
+		return NearTier;
+
+	return CurrentTier;
+}
+
+float UEnemySignificanceManager::GetTierBoundary(EEnemyLODTier Tier) const
+{
+	switch (Tier)
+	{
+	case EEnemyLODTier::Medium:
+		return MediumTierDistance;
+	case EEnemyLODTier::Low:
+		return LowTierDistance;
+	case EEnemyLODTier::Dormant:
+		return DormantTierDistance;
+	default:
+		return 0.f;
+	}
+}
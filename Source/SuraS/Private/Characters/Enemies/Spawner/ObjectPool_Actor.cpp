@@ -2,6 +2,8 @@
 
 
 #include "Characters/Enemies/Spawner/ObjectPool_Actor.h"
+#include "BrainComponent.h"
+#include "SuraSStats.h"
 
 // Sets default values
 AObjectPool_Actor::AObjectPool_Actor()
@@ -11,16 +13,34 @@ AObjectPool_Actor::AObjectPool_Actor()
 }
 
 APawn* AObjectPool_Actor::SpawnPooledObject()
+{
+	return AcquirePooledObject(GetActorLocation() + FVector(FMath::RandRange(-50, 50), FMath::RandRange(-50, 50), 0), FRotator(0, 0, 0));
+}
+
+APawn* AObjectPool_Actor::AcquirePooledObject(const FVector& Location, const FRotator& Rotation)
 {
 	for (APawn* PoolableActor : ObjectPool)
 	{
 		if (PoolableActor != nullptr && PoolableActor->IsHidden())
 		{
-			PoolableActor->TeleportTo(GetActorLocation()+FVector(FMath::RandRange(-50, 50), FMath::RandRange(-50, 50), 0), FRotator(0, 0, 0));
+			PoolableActor->TeleportTo(Location, Rotation);
 			PoolableActor->SetActorHiddenInGame(false);
 			PoolableActor->SetActorEnableCollision(true);
+
+			if (AAIController* const Controller = Cast<AAIController>(PoolableActor->GetController()))
+			{
+				if (UBrainComponent* const Brain = Controller->GetBrainComponent())
+				{
+					if (!Brain->IsRunning())
+						Brain->RestartLogic();
+				}
+			}
 			//FString error = (PoolableActor->IsHidden()) ? "true" : "false";
 			//UE_LOG(LogBlueprint, Warning, TEXT("%s"), *error);
+
+			if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(PoolableActor))
+				Enemy->OnAcquiredFromPool();
+
 			return PoolableActor;
 		}
 	}
@@ -28,16 +48,48 @@ APawn* AObjectPool_Actor::SpawnPooledObject()
 	UWorld* const World = GetWorld();
 	if (World != nullptr)
 	{
+		LLM_SCOPE_BYTAG(SuraS_Enemies);
+
 		APawn* newPoolableActor = UAIBlueprintHelperLibrary::SpawnAIFromClass(World,
-			PooledObjectSubclass, BehaviorTree, GetActorLocation() + FVector(FMath::RandRange(-50, 50), FMath::RandRange(-50, 50), 0), FRotator().ZeroRotator, true);
-		newPoolableActor->SetActorHiddenInGame(false);
-		ObjectPool.Add(newPoolableActor);
+			PooledObjectSubclass, BehaviorTree, Location, Rotation, true);
+
+		if (newPoolableActor != nullptr)
+		{
+			newPoolableActor->SetActorHiddenInGame(false);
+			ObjectPool.Add(newPoolableActor);
+
+			if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(newPoolableActor))
+				Enemy->OnAcquiredFromPool();
+		}
 		return newPoolableActor;
 	}
 
 	return nullptr;
 }
 
+void AObjectPool_Actor::ReleasePooledObject(APawn* PoolableActor)
+{
+	if (PoolableActor == nullptr)
+		return;
+
+	if (AAIController* const Controller = Cast<AAIController>(PoolableActor->GetController()))
+	{
+		Controller->StopMovement();
+
+		if (UBrainComponent* const Brain = Controller->GetBrainComponent())
+			Brain->StopLogic("Pooled");
+	}
+
+	if (ASuraCharacterEnemyBase* const Enemy = Cast<ASuraCharacterEnemyBase>(PoolableActor))
+	{
+		Enemy->ReturnToPool();
+		return;
+	}
+
+	PoolableActor->SetActorHiddenInGame(true);
+	PoolableActor->SetActorEnableCollision(false);
+}
+
 void AObjectPool_Actor::SpawnWrapper()
 {
 	for (int i = 0; i < spawnCount; i++)
@@ -78,7 +130,8 @@ void AObjectPool_Actor::BeginPlay()
 
 	}
 
-	GetWorld()->GetTimerManager().SetTimer(TimerHandler, this, &AObjectPool_Actor::SpawnWrapper, interval, true);
+	if (bSpawnOnTimer)
+		GetWorld()->GetTimerManager().SetTimer(TimerHandler, this, &AObjectPool_Actor::SpawnWrapper, interval, true);
 	
 }
 
@@ -5,8 +5,12 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
-#include "Widgets/Enemies/EnemyHealthBarWidget.h"
+#include "Widgets/Enemies/EnemyHealthBarLayerWidget.h"
 #include "Structures/Enemies/EnemyAttributesData.h"
+#include "Characters/Enemies/Significance/EnemySignificanceManager.h"
+#include "Characters/Enemies/Ragdoll/EnemyRagdollManager.h"
+#include "Characters/Enemies/Combat/EnemyMeleeHitResolver.h"
+#include "SuraSStats.h"
 
 ASuraCharacterEnemyBase::ASuraCharacterEnemyBase()
 {
@@ -14,37 +18,42 @@ ASuraCharacterEnemyBase::ASuraCharacterEnemyBase()
 	DamageSystemComp = CreateDefaultSubobject<UACDamageSystem>(TEXT("DamageSystemComponent"));
 	AddOwnedComponent(DamageSystemComp);
 
-	HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBar"));
-
-	if (HealthBarWidget)
-	{
-		HealthBarWidget->SetupAttachment(RootComponent);
-		HealthBarWidget->SetWidgetSpace(EWidgetSpace::World);
-		HealthBarWidget->SetRelativeLocation(FVector(0.f, 0.f, 1.f));
-
-		static ConstructorHelpers::FClassFinder<UUserWidget> WidgetClass{ TEXT("/Game/UI/Enemies/WBP_EnemyHealthBar") };
-
-		if (WidgetClass.Succeeded())
-		{
-			HealthBarWidget->SetWidgetClass((WidgetClass.Class));
-		}
-	}
-
 	EnemyType = "Base";
+
+	// default tick budgets, can be tuned per enemy blueprint
+	FEnemyLODTierSettings MediumTier;
+	MediumTier.ActorTickInterval = 0.1f;
+	MediumTier.MovementTickInterval = 0.033f;
+	MediumTier.AnimationTickInterval = 0.033f;
+	MediumTier.BehaviorTreeTickInterval = 0.1f;
+
+	FEnemyLODTierSettings LowTier;
+	LowTier.ActorTickInterval = 0.5f;
+	LowTier.MovementTickInterval = 0.1f;
+	LowTier.AnimationTickInterval = 0.1f;
+	LowTier.BehaviorTreeTickInterval = 0.5f;
+	LowTier.bEnablePerception = false;
+	LowTier.bUpdateHealthBar = false;
+
+	FEnemyLODTierSettings DormantTier;
+	DormantTier.ActorTickInterval = 1.f;
+	DormantTier.bEnableMovementTick = false;
+	DormantTier.AnimationTickInterval = 0.5f;
+	DormantTier.BehaviorTreeTickInterval = 1.f;
+	DormantTier.bEnablePerception = false;
+	DormantTier.bUpdateHealthBar = false;
+
+	LODTierSettings.Add(EEnemyLODTier::High, FEnemyLODTierSettings());
+	LODTierSettings.Add(EEnemyLODTier::Medium, MediumTier);
+	LODTierSettings.Add(EEnemyLODTier::Low, LowTier);
+	LODTierSettings.Add(EEnemyLODTier::Dormant, DormantTier);
 }
 
 void ASuraCharacterEnemyBase::BeginPlay()
 {
-	Super::BeginPlay();
+	LLM_SCOPE_BYTAG(SuraS_Enemies);
 
-	UpdateHealthBarValue();
-
-	HealthBarWidget->SetHiddenInGame(true);
-
-	if (UEnemyHealthBarWidget* const Widget = Cast<UEnemyHealthBarWidget>(HealthBarWidget->GetUserWidgetObject()))
-	{
-		HealthBarWidgetSize = Widget->GetHealthBarSize();
-	}
+	Super::BeginPlay();
 
 	if (DamageSystemComp)
 	{
@@ -72,39 +81,14 @@ void ASuraCharacterEnemyBase::BeginPlay()
 	}
 
 	PlayerController = GetWorld()->GetFirstPlayerController();
-}
-
-void ASuraCharacterEnemyBase::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-	
-	if (UEnemyHealthBarWidget* const Widget = Cast<UEnemyHealthBarWidget>(HealthBarWidget->GetUserWidgetObject()))
-	{
-		float Distance = FVector::Dist(GetPlayerController()->PlayerCameraManager->GetCameraLocation(), GetActorLocation());
-
-		//int32 ViewportX, ViewportY;
-		//GetPlayerController()->GetViewportSize(ViewportX, ViewportY);
-		
-		Distance = FMath::Clamp(Distance, 100, 1000);
 
-		FVector2D NewSize = GetHealthBarWidgetSize() * 500 / Distance; // * (ViewportY / 2) / FMath::Tan(FMath::DegreesToRadians(GetPlayerController()->PlayerCameraManager->GetFOVAngle() / 2))
+	// restored by ReturnToPool after a ragdoll death
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	MeshCollisionProfileName = GetMesh()->GetCollisionProfileName();
+	CapsuleCollisionProfileName = GetCapsuleComponent()->GetCollisionProfileName();
 
-		Widget->ResizeHealthBar(NewSize);
-	}
-
-	/*FHitResult Hit;
-	
-	FCollisionQueryParams CollisionQueryParams;
-	CollisionQueryParams.AddIgnoredActor(this);
-
-	GetWorld()->LineTraceSingleByChannel(Hit, EnemyLocation, CameraLocation, ECollisionChannel::ECC_Visibility, CollisionQueryParams);
-
-	DrawDebugLine(GetWorld(), EnemyLocation, CameraLocation, Hit.bBlockingHit ? FColor::Blue : FColor::Red, false, 5.0f, 0, 10.0f);
-
-	if (Hit.bBlockingHit)
-		HealthBarWidget->SetHiddenInGame(true);
-	else
-		HealthBarWidget->SetHiddenInGame(false);*/
+	if (UEnemySignificanceManager* const SignificanceManager = GetWorld()->GetSubsystem<UEnemySignificanceManager>())
+		SignificanceManager->RegisterEnemy(this);
 }
 
 void ASuraCharacterEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -112,24 +96,35 @@ void ASuraCharacterEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 
 	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+
+	if (UEnemySignificanceManager* const SignificanceManager = GetWorld()->GetSubsystem<UEnemySignificanceManager>())
+		SignificanceManager->UnregisterEnemy(this);
+
+	SetAcquiredFromPool(false);
 }
 
-void ASuraCharacterEnemyBase::OnDamagedTriggered()
+void ASuraCharacterEnemyBase::SetAcquiredFromPool(bool bAcquired)
 {
-	if (GetWorldTimerManager().IsTimerActive(HideHealthBarHandle))
-		GetWorldTimerManager().ClearTimer(HideHealthBarHandle);
+	if (bIsAcquiredFromPool == bAcquired)
+		return;
 
-	GetWorldTimerManager().SetTimer(
-		HideHealthBarHandle,
-		FTimerDelegate::CreateLambda([&]() { HealthBarWidget->SetHiddenInGame(true); }),
-		1.f,
-		false
-	);
+	bIsAcquiredFromPool = bAcquired;
 
-	UpdateHealthBarValue();
-	HealthBarWidget->SetHiddenInGame(false);
+	if (bAcquired)
+	{
+		INC_DWORD_STAT(STAT_SuraLiveEnemies);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_SuraLiveEnemies);
+	}
+}
 
-	Cast<UEnemyHealthBarWidget>(HealthBarWidget->GetUserWidgetObject())->PlayFadeAnimtion();
+void ASuraCharacterEnemyBase::OnDamagedTriggered()
+{
+	// the layer hides the bar again on its own after a moment
+	if (UEnemyHealthBarLayerWidget* const HealthBarLayer = GetHealthBarLayer())
+		HealthBarLayer->ShowHealthBar(this, GetDamageSystemComp()->GetHealth() / GetDamageSystemComp()->GetMaxHealth());
 
 	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Yellow, FString::Printf(TEXT("%s"), *(HitAnimation->GetFName()).ToString()));
 
@@ -155,29 +150,84 @@ void ASuraCharacterEnemyBase::OnDeathTriggered()
 
 	// GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Yellow, FString::Printf(TEXT("%s"), GetCapsuleComponent()->IsSimulatingPhysics() ? TEXT("true") : TEXT("false")));
 
-	// Ragdoll physics
-	GetMesh()->SetCollisionProfileName(TEXT("Ragdoll"));
-	GetMesh()->SetSimulatePhysics(true);
-	GetMesh()->SetCollisionObjectType(ECC_GameTraceChannel1); // to disable collision with SuraProjectile object
+	// Ragdoll physics, within the global ragdoll budget
+	UEnemyRagdollManager* const RagdollManager = GetWorld()->GetSubsystem<UEnemyRagdollManager>();
+
+	if (!RagdollManager || !RagdollManager->RequestRagdoll(this))
+	{
+		// over budget: keep the death animation and hold its last pose instead of blending back to locomotion
+		if (DeathAnimation)
+		{
+			FOnMontageBlendingOutStarted OnDeathBlendingOut;
+			OnDeathBlendingOut.BindWeakLambda(this, [this](UAnimMontage* Montage, bool bInterrupted) { GetMesh()->bPauseAnims = true; });
+
+			GetMesh()->GetAnimInstance()->Montage_SetBlendingOutDelegate(OnDeathBlendingOut, DeathAnimation);
+		}
+	}
 
 	//objectpoolDisableEnemy
 	FTimerHandle DeathHandle;
 
 	GetWorldTimerManager().SetTimer(
 		DeathHandle,
-		FTimerDelegate::CreateLambda([&]() { SetActorHiddenInGame(true); }),
+		this,
+		&ASuraCharacterEnemyBase::ReturnToPool,
 		3.f,
 		false
 	);
 }
 
+void ASuraCharacterEnemyBase::ReturnToPool()
+{
+	if (UEnemyRagdollManager* const RagdollManager = GetWorld()->GetSubsystem<UEnemyRagdollManager>())
+		RagdollManager->ReleaseRagdoll(this);
+
+	if (UEnemyHealthBarLayerWidget* const HealthBarLayer = GetHealthBarLayer())
+		HealthBarLayer->HideHealthBar(this);
+
+	// a window left open by an interrupted attack would otherwise follow the pawn to its next acquire
+	if (UEnemyMeleeHitResolver* const MeleeHitResolver = GetWorld()->GetSubsystem<UEnemyMeleeHitResolver>())
+		MeleeHitResolver->RemoveAttackWindows(this);
+
+	// the ragdoll detached the mesh from the capsule, put everything back the way BeginPlay found it
+	USkeletalMeshComponent* const MeshComp = GetMesh();
+
+	MeshComp->bPauseAnims = false;
+	MeshComp->SetSimulatePhysics(false);
+	MeshComp->SetCollisionProfileName(MeshCollisionProfileName);
+	MeshComp->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	MeshComp->SetRelativeTransform(MeshRelativeTransform);
+
+	if (UAnimInstance* const AnimInstance = MeshComp->GetAnimInstance())
+		AnimInstance->StopAllMontages(0.f);
+
+	GetCapsuleComponent()->SetCollisionProfileName(CapsuleCollisionProfileName);
+
+	GetDamageSystemComp()->SetHealth(GetDamageSystemComp()->GetMaxHealth());
+	GetDamageSystemComp()->SetIsDead(false);
+	UpdateHealthBarValue();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	SetAcquiredFromPool(false);
+}
+
 void ASuraCharacterEnemyBase::UpdateHealthBarValue()
 {
 	const float Health = GetDamageSystemComp()->GetHealth();
 	const float MaxHealth = GetDamageSystemComp()->GetMaxHealth();
 
-	if (UEnemyHealthBarWidget* const Widget = Cast<UEnemyHealthBarWidget>(HealthBarWidget->GetUserWidgetObject()))
-		Widget->SetHealthBarPercent(Health / MaxHealth);
+	if (UEnemyHealthBarLayerWidget* const HealthBarLayer = GetHealthBarLayer())
+		HealthBarLayer->UpdateHealthBar(this, Health / MaxHealth);
+}
+
+UEnemyHealthBarLayerWidget* ASuraCharacterEnemyBase::GetHealthBarLayer() const
+{
+	if (const ASuraCharacterPlayer* const Player = PlayerController ? Cast<ASuraCharacterPlayer>(PlayerController->GetPawn()) : nullptr)
+		return Player->GetEnemyHealthBarLayer();
+
+	return nullptr;
 }
 
 bool ASuraCharacterEnemyBase::TakeDamage(const FDamageData& DamageData, const AActor* DamageCauser)
@@ -197,4 +247,44 @@ void ASuraCharacterEnemyBase::Attack(const ASuraCharacterPlayer* Player)
 void ASuraCharacterEnemyBase::SetUpAIController(AEnemyBaseAIController* const NewAIController)
 {
 	AIController = NewAIController;
+
+	// a new controller starts at full rate, bring it in line with the current tier
+	if (AIController)
+	{
+		if (const FEnemyLODTierSettings* const Settings = LODTierSettings.Find(LODTier))
+			AIController->ApplyLODTierSettings(*Settings);
+	}
+}
+
+void ASuraCharacterEnemyBase::ApplyLODTier(EEnemyLODTier NewTier)
+{
+	if (NewTier == LODTier)
+		return;
+
+	const FEnemyLODTierSettings* const Settings = LODTierSettings.Find(NewTier);
+
+	if (!Settings)
+		return;
+
+	LODTier = NewTier;
+
+	SetActorTickInterval(Settings->ActorTickInterval);
+
+	GetCharacterMovement()->SetComponentTickEnabled(Settings->bEnableMovementTick);
+	GetCharacterMovement()->SetComponentTickInterval(Settings->MovementTickInterval);
+
+	GetMesh()->SetComponentTickInterval(Settings->AnimationTickInterval);
+
+	bUpdateHealthBar = Settings->bUpdateHealthBar;
+
+	if (AIController)
+		AIController->ApplyLODTierSettings(*Settings);
+}
+
+void ASuraCharacterEnemyBase::RestoreHealth(float NewHealth)
+{
+	GetDamageSystemComp()->SetHealth(FMath::Min(NewHealth, GetDamageSystemComp()->GetMaxHealth()));
+	GetDamageSystemComp()->SetIsDead(NewHealth <= 0.f);
+
+	UpdateHealthBarValue();
 }
\ No newline at end of file
@@ -26,6 +26,11 @@
 #include "Extensions/UIComponent.h"
 
 #include "ActorComponents/WeaponSystem/WeaponSystemComponent.h"
+#include "Widgets/Enemies/EnemyHealthBarLayerWidget.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Player Tick"), STAT_SuraPlayerTick, STATGROUP_SuraS);
+DECLARE_CYCLE_STAT(TEXT("Player UpdateState"), STAT_SuraPlayerUpdateState, STATGROUP_SuraS);
 
 ASuraCharacterPlayer::ASuraCharacterPlayer()
 {
@@ -67,6 +72,12 @@ ASuraCharacterPlayer::ASuraCharacterPlayer()
 	if (WidgetClass.Succeeded())
 		HitEffectWidgetClass = WidgetClass.Class;
 
+	// Enemy health bars are drawn by a single HUD layer, pooling this widget per visible bar
+	static ConstructorHelpers::FClassFinder<UEnemyHealthBarWidget> EnemyHealthBarClass{ TEXT("/Game/UI/Enemies/WBP_EnemyHealthBar") };
+
+	if (EnemyHealthBarClass.Succeeded())
+		EnemyHealthBarWidgetClass = EnemyHealthBarClass.Class;
+
 
 	// WeaponSystem
 	WeaponSystem = CreateDefaultSubobject<UWeaponSystemComponent>(TEXT("WeaponSystem"));
@@ -126,14 +137,28 @@ void ASuraCharacterPlayer::BeginPlay()
 	// Hit Effect Widget Init - by Yoony
 	if (IsValid(HitEffectWidgetClass))
 	{
+		LLM_SCOPE_BYTAG(SuraS_UI);
+
 		HitEffectWidget = Cast<UPlayerHitWidget>(CreateWidget<UPlayerHitWidget>(GetWorld(), HitEffectWidgetClass));
 		
 		if (IsValid(HitEffectWidget))
 		{
+			INC_DWORD_STAT(STAT_SuraWidgetsCreated);
 			HitEffectWidget->AddToViewport();
-			HitEffectWidget->SetVisibility(ESlateVisibility::Hidden);
+			HitEffectWidget->SetVisibility(ESlateVisibility::Collapsed);
 		}
 	}
+
+	LLM_SCOPE_BYTAG(SuraS_UI);
+
+	EnemyHealthBarLayer = CreateWidget<UEnemyHealthBarLayerWidget>(GetWorld(), UEnemyHealthBarLayerWidget::StaticClass());
+
+	if (IsValid(EnemyHealthBarLayer))
+	{
+		INC_DWORD_STAT(STAT_SuraWidgetsCreated);
+		EnemyHealthBarLayer->SetHealthBarWidgetClass(EnemyHealthBarWidgetClass);
+		EnemyHealthBarLayer->AddToViewport();
+	}
 }
 
 void ASuraCharacterPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -325,7 +350,6 @@ void ASuraCharacterPlayer::OnDamaged()
 {
 	GEngine->AddOnScreenDebugMessage(-1, 15.0f, FColor::Yellow, TEXT("Player Damaged"));
 
-	HitEffectWidget->SetVisibility(ESlateVisibility::Visible);
 	HitEffectWidget->PlayFadeAnimtion();
 }
 
@@ -375,6 +399,8 @@ void ASuraCharacterPlayer::InterpCameraFOV(float DeltaTime)
 
 void ASuraCharacterPlayer::Tick(float DeltaTime)
 {
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraPlayerTick);
+
 	Super::Tick(DeltaTime);
 
 	XYSpeed = FVector(GetCharacterMovement()->Velocity.X, GetCharacterMovement()->Velocity.Y, 0.f).Size();
@@ -389,6 +415,7 @@ void ASuraCharacterPlayer::Tick(float DeltaTime)
 
 	if (CurrentState)
 	{
+		SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraPlayerUpdateState);
 		CurrentState->UpdateState(this, DeltaTime);
 	}
 	
@@ -485,10 +512,12 @@ bool ASuraCharacterPlayer::ShouldEnterWallRunning(FVector& OutWallRunDirection,
 	FCollisionQueryParams Params;
 	Params.AddIgnoredActor(this);
 	FHitResult LeftHit;
+	SURAS_COUNT_TRACE();
 	bool bLeftHit = GetWorld()->LineTraceSingleByChannel(LeftHit, GetActorLocation(),
 		GetActorLocation() + GetActorRightVector() * -45.f, ECC_Visibility, Params);
 	bool bLeftWallRunnable = false;
 	FHitResult RightHit;
+	SURAS_COUNT_TRACE();
 	bool bRightHit = GetWorld()->LineTraceSingleByChannel(RightHit, GetActorLocation(),
 		GetActorLocation() + GetActorRightVector() * 45.f, ECC_Visibility, Params);
 	bool bRightWallRunnable = false;
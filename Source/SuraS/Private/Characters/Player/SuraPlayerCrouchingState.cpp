@@ -13,6 +13,7 @@
 #include "Characters/Player/SuraPlayerWalkingState.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SuraSStats.h"
 
 
 USuraPlayerCrouchingState::USuraPlayerCrouchingState()
@@ -81,6 +82,7 @@ void USuraPlayerCrouchingState::UpdateState(ASuraCharacterPlayer* Player, float
 	UpperParams.AddIgnoredActor(Player);
 	FVector Start = Player->GetCharacterMovement()->CurrentFloor.HitResult.Location + 30.f;
 	FVector End = Start + FVector::UpVector * Player->GetDefaultCapsuleHalfHeight() * 2.f - 30.f;
+	SURAS_COUNT_TRACE();
 	bool bUpperHit = GetWorld()->SweepSingleByChannel(UpperHit, Start, End, FQuat::Identity, ECC_Visibility,
 		FCollisionShape::MakeSphere(50.f), UpperParams);
 
@@ -14,6 +14,7 @@
 #include "Characters/Player/SuraPlayerWallRunningState.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SuraSStats.h"
 
 USuraPlayerFallingState::USuraPlayerFallingState()
 {
@@ -82,6 +83,7 @@ void USuraPlayerFallingState::CacheSlidingDirection(ASuraCharacterPlayer* Player
 	FVector End = Start + FVector::DownVector * Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() - 50.f;
 	FCollisionQueryParams SlideDirectionParams;
 	SlideDirectionParams.AddIgnoredActor(Player);
+	SURAS_COUNT_TRACE();
 	bool bSlideDirectionHit = GetWorld()->LineTraceSingleByChannel(SlideDirectionHitResult, Start, End, ECC_Visibility, SlideDirectionParams);
 	if (bSlideDirectionHit)
 	{
@@ -107,6 +109,7 @@ void USuraPlayerFallingState::UpdateState(ASuraCharacterPlayer* Player, float De
 	
 	const FVector WallDetectStart = Player->GetActorLocation();
 	const FVector WallDetectEnd = WallDetectStart + Player->GetActorForwardVector() * 35.f;
+	SURAS_COUNT_TRACE();
 	const bool bWallHit = GetWorld()->SweepSingleByChannel(WallHitResult, WallDetectStart, WallDetectEnd, FQuat::Identity,
 		ECC_GameTraceChannel2, FCollisionShape::MakeCapsule(34,
 			88.f * 0.85f), WallParams);
@@ -122,6 +125,7 @@ void USuraPlayerFallingState::UpdateState(ASuraCharacterPlayer* Player, float De
 			Player->GetCamera()->GetComponentLocation().Z + 100.f);
 		FVector LedgeDetectEnd = FVector(LedgeDetectStart.X, LedgeDetectStart.Y, WallHitResult.ImpactPoint.Z);
 	
+		SURAS_COUNT_TRACE();
 		bool bLedgeHit = GetWorld()->SweepSingleByChannel(LedgeHitResult, LedgeDetectStart, LedgeDetectEnd, FQuat::Identity,
 			ECC_GameTraceChannel2, FCollisionShape::MakeSphere(20.f), LedgeParams);
 	
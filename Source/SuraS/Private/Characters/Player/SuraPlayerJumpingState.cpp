@@ -14,6 +14,7 @@
 #include "Characters/Player/SuraPlayerWallRunningState.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SuraSStats.h"
 
 USuraPlayerJumpingState::USuraPlayerJumpingState()
 {
@@ -108,6 +109,7 @@ void USuraPlayerJumpingState::UpdateState(ASuraCharacterPlayer* Player, float De
 
 		const FVector WallDetectStart = Player->GetActorLocation();
 		const FVector WallDetectEnd = WallDetectStart + Player->GetActorForwardVector() * 35.f;
+		SURAS_COUNT_TRACE();
 		const bool bWallHit = GetWorld()->SweepSingleByChannel(WallHitResult, WallDetectStart, WallDetectEnd, FQuat::Identity,
 			ECC_GameTraceChannel2, FCollisionShape::MakeCapsule(34.f,
 				Player->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 0.85f), WallParams);
@@ -123,6 +125,7 @@ void USuraPlayerJumpingState::UpdateState(ASuraCharacterPlayer* Player, float De
 				Player->GetCamera()->GetComponentLocation().Z + 100.f);
 			FVector LedgeDetectEnd = FVector(LedgeDetectStart.X, LedgeDetectStart.Y, WallHitResult.ImpactPoint.Z);
 
+			SURAS_COUNT_TRACE();
 			bool bLedgeHit = GetWorld()->SweepSingleByChannel(LedgeHitResult, LedgeDetectStart, LedgeDetectEnd, FQuat::Identity,
 				ECC_GameTraceChannel2, FCollisionShape::MakeSphere(20.f), LedgeParams);
 
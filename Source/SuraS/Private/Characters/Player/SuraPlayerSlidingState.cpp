@@ -13,6 +13,7 @@
 #include "Characters/Player/SuraPlayerWalkingState.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SuraSStats.h"
 
 USuraPlayerSlidingState::USuraPlayerSlidingState()
 {
@@ -66,6 +67,7 @@ void USuraPlayerSlidingState::UpdateState(ASuraCharacterPlayer* Player, float De
 	UpperParams.AddIgnoredActor(Player);
 	FVector Start = Player->GetCharacterMovement()->CurrentFloor.HitResult.Location;
 	FVector End = Start + FVector::UpVector * Player->GetDefaultCapsuleHalfHeight() * 2.f + 30.f;
+	SURAS_COUNT_TRACE();
 	bool bUpperHit = GetWorld()->SweepSingleByChannel(UpperHit, Start, End, FQuat::Identity, ECC_Visibility,
 		FCollisionShape::MakeSphere(50.f), UpperParams);
 
@@ -10,6 +10,7 @@
 #include "Characters/Player/SuraPlayerJumpingState.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "SuraSStats.h"
 
 
 USuraPlayerWallRunningState::USuraPlayerWallRunningState()
@@ -104,6 +105,7 @@ void USuraPlayerWallRunningState::UpdateState(ASuraCharacterPlayer* Player, floa
 
 	if (!bFrontWallFound)
 	{
+		SURAS_COUNT_TRACE();
 		bool bFrontWallHit = GetWorld()->LineTraceSingleByChannel(
 		FrontWallHit,
 		Player->GetActorLocation(),
@@ -163,6 +165,7 @@ void USuraPlayerWallRunningState::UpdateState(ASuraCharacterPlayer* Player, floa
 			FVector::CrossProduct(Player->WallRunDirection, FVector::DownVector).GetSafeNormal() * 200.f;
 	}
 
+	SURAS_COUNT_TRACE();
 	bool bWallHit = GetWorld()->LineTraceSingleByChannel(
 		WallHit,
 		Player->GetActorLocation(),
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Preload/SuraPreloadManager.h"
+#include "Preload/SuraPreloadManifest.h"
+
+#include "Engine/AssetManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR
+#include "EngineUtils.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#endif
+
+namespace
+{
+	// far below the level, out of sight of the player
+	const FVector WarmUpLocation(0.f, 0.f, -100000.f);
+
+#if WITH_EDITOR
+	FAutoConsoleCommandWithWorld BuildPreloadManifestCommand(
+		TEXT("Sura.BuildPreloadManifest"),
+		TEXT("Scans the current level's weapon pick ups and object pools and saves its preload manifest."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (!World)
+				return;
+
+			const FString ObjectPath = USuraPreloadManager::GetManifestObjectPath(GetDefault<USuraPreloadManager>()->GetManifestDirectory(), World);
+			const FString PackageName = FPackageName::ObjectPathToPackageName(ObjectPath);
+			const FString AssetName = FPackageName::ObjectPathToObjectName(ObjectPath);
+
+			UPackage* Package = CreatePackage(*PackageName);
+			USuraPreloadManifest* Manifest = FindObject<USuraPreloadManifest>(Package, *AssetName);
+
+			if (!Manifest)
+				Manifest = NewObject<USuraPreloadManifest>(Package, *AssetName, RF_Public | RF_Standalone);
+
+			Manifest->BuildFromWorld(World);
+			Package->MarkPackageDirty();
+
+			FSavePackageArgs SaveArgs;
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+			const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+
+			if (UPackage::SavePackage(Package, Manifest, *Filename, SaveArgs))
+			{
+				UE_LOG(LogTemp, Log, TEXT("Preload manifest %s saved with %d assets"), *ObjectPath, Manifest->Assets.Num());
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to save preload manifest %s"), *ObjectPath);
+			}
+		}));
+#endif
+}
+
+bool USuraPreloadManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FString USuraPreloadManager::GetManifestObjectPath(const FString& Directory, const UWorld* World)
+{
+	const FString MapName = UWorld::RemovePIEPrefix(World->GetMapName());
+	const FString AssetName = FString::Printf(TEXT("PM_%s"), *MapName);
+
+	return FString::Printf(TEXT("%s/%s.%s"), *Directory, *AssetName, *AssetName);
+}
+
+void USuraPreloadManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	Manifest = LoadObject<USuraPreloadManifest>(nullptr, *GetManifestObjectPath(ManifestDirectory, &InWorld), nullptr, LOAD_NoWarn | LOAD_Quiet);
+
+	if (!Manifest || Manifest->Assets.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No preload manifest for %s, assets will load on first use"), *InWorld.GetMapName());
+		OnPreloadLoaded();
+		return;
+	}
+
+	PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Manifest->Assets,
+		FStreamableDelegate::CreateUObject(this, &USuraPreloadManager::OnPreloadLoaded), FStreamableManager::AsyncLoadHighPriority);
+
+	// still part of the level load, finish as much as possible before the first frame
+	if (PreloadHandle.IsValid() && !PreloadHandle->HasLoadCompleted() && MaxBlockingPreloadTime > 0.f)
+	{
+		PreloadHandle->WaitUntilComplete(MaxBlockingPreloadTime);
+	}
+}
+
+void USuraPreloadManager::Deinitialize()
+{
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadDelegateHandle);
+
+	if (bWriteHitchReport && bPreloadComplete)
+	{
+		WriteHitchReport();
+	}
+
+	// the manifest's assets stay referenced for the whole level only
+	if (PreloadHandle.IsValid())
+	{
+		PreloadHandle->ReleaseHandle();
+		PreloadHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void USuraPreloadManager::OnPreloadLoaded()
+{
+	if (bPreloadComplete)
+		return;
+
+	WarmUp();
+
+	bPreloadComplete = true;
+
+	// from here on every synchronous load is a gameplay hitch
+	SyncLoadDelegateHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(this, &USuraPreloadManager::OnSyncLoadPackage);
+
+	OnPreloadComplete.Broadcast();
+}
+
+void USuraPreloadManager::WarmUp()
+{
+	if (!PreloadHandle.IsValid())
+		return;
+
+	TArray<UObject*> LoadedAssets;
+	PreloadHandle->GetLoadedAssets(LoadedAssets);
+
+	UWorld* World = GetWorld();
+
+	for (UObject* Asset : LoadedAssets)
+	{
+		if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Asset))
+		{
+			// creates the system instance and its render resources once
+			if (UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, NiagaraSystem, WarmUpLocation, FRotator::ZeroRotator, FVector(1.f), true, true, ENCPoolMethod::None, false))
+			{
+				NiagaraComponent->DeactivateImmediate();
+			}
+		}
+		else if (USoundBase* Sound = Cast<USoundBase>(Asset))
+		{
+			// decodes the first chunk so the first play doesn't wait on it
+			UGameplayStatics::PrimeSound(Sound);
+		}
+	}
+
+	// pooled enemies are spawned by the pools themselves on BeginPlay
+}
+
+void USuraPreloadManager::OnSyncLoadPackage(const FString& PackageName)
+{
+	FLazyLoad LazyLoad;
+	LazyLoad.AssetName = PackageName;
+	LazyLoad.Time = GetWorld()->GetTimeSeconds();
+	LazyLoad.bSynchronous = true;
+
+	LazyLoads.Add(LazyLoad);
+}
+
+void USuraPreloadManager::ReportLazyLoad(const FSoftObjectPath& AssetPath)
+{
+	if (!bPreloadComplete)
+		return;
+
+	FLazyLoad LazyLoad;
+	LazyLoad.AssetName = AssetPath.ToString();
+	LazyLoad.Time = GetWorld()->GetTimeSeconds();
+
+	LazyLoads.Add(LazyLoad);
+}
+
+void USuraPreloadManager::WriteHitchReport() const
+{
+#if !UE_BUILD_SHIPPING
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+
+	FString Report = FString::Printf(TEXT("Preload hitch report for %s\n%d asset(s) loaded on demand during gameplay\n\n"), *MapName, LazyLoads.Num());
+
+	for (const FLazyLoad& LazyLoad : LazyLoads)
+	{
+		Report += FString::Printf(TEXT("%8.2fs  %-5s  %s\n"), LazyLoad.Time, LazyLoad.bSynchronous ? TEXT("sync") : TEXT("async"), *LazyLoad.AssetName);
+		UE_LOG(LogTemp, Warning, TEXT("Lazy load during gameplay (%s) at %.2fs: %s"), LazyLoad.bSynchronous ? TEXT("sync") : TEXT("async"), LazyLoad.Time, *LazyLoad.AssetName);
+	}
+
+	const FString Filename = FPaths::Combine(FPaths::ProfilingDir(), FString::Printf(TEXT("PreloadHitchReport_%s.txt"), *MapName));
+	FFileHelper::SaveStringToFile(Report, *Filename);
+#endif
+}
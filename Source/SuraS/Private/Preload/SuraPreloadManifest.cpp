@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Preload/SuraPreloadManifest.h"
+
+#if WITH_EDITOR
+#include "ActorComponents/WeaponSystem/ACWeapon.h"
+#include "ActorComponents/WeaponSystem/SuraWeaponPickUp.h"
+#include "ActorComponents/WeaponSystem/WeaponAssetStreamingManager.h"
+#include "ActorComponents/WeaponSystem/WeaponData.h"
+#include "Characters/Enemies/Spawner/ObjectPool_Actor.h"
+#include "EngineUtils.h"
+
+void USuraPreloadManifest::BuildFromWorld(UWorld* World)
+{
+	Assets.Reset();
+
+	if (!World)
+		return;
+
+	TSet<const UDataTable*> WeaponDataTables;
+
+	for (TActorIterator<ASuraWeaponPickUp> It(World); It; ++It)
+	{
+		const UACWeapon* Weapon = It->GetWeaponClass() ? It->GetWeaponClass()->GetDefaultObject<UACWeapon>() : nullptr;
+
+		if (!Weapon)
+			continue;
+
+		UWeaponAssetStreamingManager::GatherWeaponAssetPaths(Weapon, It->GetWeaponName(), Assets);
+
+		if (Weapon->WeaponDataTable)
+			WeaponDataTables.Add(Weapon->WeaponDataTable);
+	}
+
+	// the inventory shows every weapon of the table, not only the placed ones
+	for (const UDataTable* WeaponDataTable : WeaponDataTables)
+	{
+		WeaponDataTable->ForeachRow<FWeaponData>(TEXT(""), [this](const FName& RowName, const FWeaponData& WeaponData)
+		{
+			if (!WeaponData.WeaponImage.IsNull())
+				Assets.AddUnique(WeaponData.WeaponImage.ToSoftObjectPath());
+		});
+	}
+
+	for (TActorIterator<AObjectPool_Actor> It(World); It; ++It)
+	{
+		if (It->PooledObjectSubclass)
+			Assets.AddUnique(FSoftObjectPath(It->PooledObjectSubclass.Get()));
+	}
+
+	Assets.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+}
+#endif
@@ -0,0 +1,498 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Profiling/SuraBenchmarkManager.h"
+#include "ActorComponents/WeaponSystem/ACWeapon.h"
+#include "ActorComponents/WeaponSystem/SuraWeaponPickUp.h"
+#include "ActorComponents/WeaponSystem/WeaponSystemComponent.h"
+#include "Characters/Player/SuraCharacterPlayer.h"
+#include "Characters/Enemies/Spawner/ObjectPool_Actor.h"
+#include "SuraSStats.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "NavigationSystem.h"
+#include "EngineUtils.h"
+#include "RenderCore.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	// the weapon switch is driven by the equip and unequip animations, so a new one is only requested after this long
+	constexpr float WeaponSwitchInterval = 1.f;
+
+	// the scenario is skipped if its weapon is still not equipped after this long
+	constexpr float WeaponSwitchTimeout = 10.f;
+
+	constexpr float EnemyRefillInterval = 1.f;
+
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem(const UWorld* World)
+	{
+		const APlayerController* const PlayerController = World->GetFirstPlayerController();
+		return PlayerController ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+	}
+
+	// nearest rank, Values must be sorted
+	float Percentile(const TArray<float>& Values, float Ratio)
+	{
+		if (Values.IsEmpty())
+			return 0.f;
+
+		return Values[FMath::Clamp(FMath::CeilToInt(Ratio * Values.Num()) - 1, 0, Values.Num() - 1)];
+	}
+}
+
+bool USuraBenchmarkManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USuraBenchmarkManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+#if !UE_BUILD_SHIPPING
+	FString ScenarioName;
+
+	if (!FParse::Value(FCommandLine::Get(), TEXT("SuraBenchmark="), ScenarioName) && !FParse::Param(FCommandLine::Get(), TEXT("SuraBenchmark")))
+		return;
+
+	for (const FSuraBenchmarkScenario& Scenario : Scenarios)
+	{
+		if (ScenarioName.IsEmpty() || Scenario.Name == ScenarioName)
+			ActiveScenarios.Add(Scenario);
+	}
+
+	if (ActiveScenarios.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark has no scenario named '%s'"), *ScenarioName);
+		FPlatformMisc::RequestExit(false, TEXT("SuraBenchmark"));
+		return;
+	}
+
+	RunName = FDateTime::Now().ToString();
+
+	PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &USuraBenchmarkManager::OnPreGarbageCollect);
+	PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &USuraBenchmarkManager::OnPostGarbageCollect);
+
+	bStartPending = true;
+#endif
+}
+
+void USuraBenchmarkManager::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGCHandle);
+
+	Super::Deinitialize();
+}
+
+void USuraBenchmarkManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRunning())
+		return;
+
+	if (bStartPending)
+	{
+		const APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+
+		if (!PlayerController || !Cast<ASuraCharacterPlayer>(PlayerController->GetPawn()))
+			return;
+
+		bStartPending = false;
+
+		PlaceWeaponPickUps();
+		StartScenario(0);
+		return;
+	}
+
+	// real time between ticks, the world's delta is clamped and dilated
+	const double Now = FPlatformTime::Seconds();
+	const float FrameTime = LastFrameTime > 0.0 ? Now - LastFrameTime : DeltaTime;
+	LastFrameTime = Now;
+
+	const FSuraBenchmarkScenario& Scenario = ActiveScenarios[ScenarioIndex];
+
+	PhaseTime += DeltaTime;
+
+	if (Phase == EPhase::WarmUp && !EquipScenarioWeapon(Scenario, DeltaTime))
+	{
+		if (PhaseTime >= WeaponSwitchTimeout)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Benchmark scenario %s skipped, %s could not be equipped"),
+				*Scenario.Name, *UEnum::GetDisplayValueAsText(Scenario.WeaponName).ToString());
+
+			Samples.Reset();
+			FinishScenario();
+		}
+
+		return;
+	}
+
+	AimAtNearestEnemy();
+	UpdateScriptedInput(Scenario, DeltaTime);
+
+	if (Phase == EPhase::WarmUp)
+	{
+		if (PhaseTime >= Scenario.WarmUpTime)
+		{
+			Phase = EPhase::Measure;
+			PhaseTime = 0.f;
+			PendingGCTime = 0.f;
+#if !UE_BUILD_SHIPPING
+			LastNumTraces = GSuraNumTraces;
+#endif
+		}
+
+		return;
+	}
+
+	RecordFrame(FrameTime);
+
+	if (FMath::Fmod(PhaseTime, EnemyRefillInterval) < DeltaTime)
+		SpawnEnemies(Scenario);
+
+	if (PhaseTime >= Scenario.Duration)
+		FinishScenario();
+}
+
+TStatId USuraBenchmarkManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USuraBenchmarkManager, STATGROUP_Tickables);
+}
+
+void USuraBenchmarkManager::PlaceWeaponPickUps()
+{
+	ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(GetWorld()->GetFirstPlayerController()->GetPawn());
+	UWeaponSystemComponent* const WeaponSystem = Player->GetWeaponSystemComponent();
+
+	for (const TSoftClassPtr<ASuraWeaponPickUp>& WeaponPickUpClass : WeaponPickUpClasses)
+	{
+		UClass* const Class = WeaponPickUpClass.LoadSynchronous();
+
+		if (!Class)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Benchmark could not load weapon pick up %s"), *WeaponPickUpClass.ToString());
+			continue;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const FVector Location = Player->GetActorLocation() + Player->GetActorForwardVector() * 100.f;
+
+		if (ASuraWeaponPickUp* const WeaponPickUp = GetWorld()->SpawnActor<ASuraWeaponPickUp>(Class, Location, FRotator::ZeroRotator, SpawnParams))
+			WeaponSystem->ObtainNewWeapon(WeaponPickUp);
+	}
+}
+
+void USuraBenchmarkManager::StartScenario(int32 Index)
+{
+	if (!ActiveScenarios.IsValidIndex(Index))
+	{
+		ScenarioIndex = INDEX_NONE;
+		Phase = EPhase::Idle;
+
+		UE_LOG(LogTemp, Log, TEXT("Benchmark finished, results in %s"), *FPaths::Combine(FPaths::ProfilingDir(), TEXT("SuraBenchmark")));
+		FPlatformMisc::RequestExit(false, TEXT("SuraBenchmark"));
+		return;
+	}
+
+	const FSuraBenchmarkScenario& Scenario = ActiveScenarios[Index];
+
+	ScenarioIndex = Index;
+	Phase = EPhase::WarmUp;
+	PhaseTime = 0.f;
+	SwitchTime = WeaponSwitchInterval;
+	// the first frame with the weapon equipped starts a new input cycle
+	InputTime = Scenario.HoldTime + Scenario.ReleaseTime;
+	LastFrameTime = 0.0;
+
+	Samples.Reset();
+	Samples.Reserve(FMath::CeilToInt(Scenario.Duration * 120.f));
+
+	SpawnEnemies(Scenario);
+
+	UE_LOG(LogTemp, Log, TEXT("Benchmark scenario %s started with %d enemies"), *Scenario.Name, Enemies.Num());
+}
+
+void USuraBenchmarkManager::FinishScenario()
+{
+	SetInputHeld(nullptr, false);
+
+	if (!Samples.IsEmpty())
+		WriteScenarioResults(ActiveScenarios[ScenarioIndex]);
+
+	ReleaseEnemies();
+	StartScenario(ScenarioIndex + 1);
+}
+
+void USuraBenchmarkManager::SpawnEnemies(const FSuraBenchmarkScenario& Scenario)
+{
+	Enemies.RemoveAll([](const FBenchmarkEnemy& Enemy)
+	{
+		return !Enemy.Pool.IsValid() || !Enemy.Pawn.IsValid() || Enemy.Pawn->IsHidden();
+	});
+
+	TArray<AObjectPool_Actor*> Pools;
+
+	for (TActorIterator<AObjectPool_Actor> It(GetWorld()); It; ++It)
+		Pools.Add(*It);
+
+	if (Pools.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Benchmark level has no object pool, scenario %s runs without enemies"), *Scenario.Name);
+		return;
+	}
+
+	const APawn* const Player = GetWorld()->GetFirstPlayerController()->GetPawn();
+	const FVector Origin = Player->GetActorLocation();
+
+	UNavigationSystemV1* const NavSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+
+	for (int32 i = Enemies.Num(); i < Scenario.EnemyCount; ++i)
+	{
+		FNavLocation NavLocation;
+		FVector Location = Origin + FVector(FMath::RandPointInCircle(Scenario.SpawnRadius), 0.f);
+
+		if (NavSystem && NavSystem->GetRandomReachablePointInRadius(Origin, Scenario.SpawnRadius, NavLocation))
+			Location = NavLocation.Location;
+
+		AObjectPool_Actor* const Pool = Pools[i % Pools.Num()];
+
+		if (APawn* const Pawn = Pool->AcquirePooledObject(Location, (Origin - Location).Rotation()))
+			Enemies.Add({ Pool, Pawn });
+	}
+}
+
+void USuraBenchmarkManager::ReleaseEnemies()
+{
+	for (const FBenchmarkEnemy& Enemy : Enemies)
+	{
+		if (Enemy.Pool.IsValid() && Enemy.Pawn.IsValid() && !Enemy.Pawn->IsHidden())
+			Enemy.Pool->ReleasePooledObject(Enemy.Pawn.Get());
+	}
+
+	Enemies.Reset();
+}
+
+bool USuraBenchmarkManager::EquipScenarioWeapon(const FSuraBenchmarkScenario& Scenario, float DeltaTime)
+{
+	const ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(GetWorld()->GetFirstPlayerController()->GetPawn());
+	UWeaponSystemComponent* const WeaponSystem = Player ? Player->GetWeaponSystemComponent() : nullptr;
+
+	if (!WeaponSystem)
+		return false;
+
+	const UACWeapon* const CurrentWeapon = WeaponSystem->GetCurrentWeapon();
+
+	if (CurrentWeapon && CurrentWeapon->GetWeaponName() == Scenario.WeaponName)
+		return true;
+
+	SwitchTime += DeltaTime;
+
+	if (SwitchTime >= WeaponSwitchInterval)
+	{
+		SwitchTime = 0.f;
+		WeaponSystem->SwitchToNextWeapon();
+	}
+
+	return false;
+}
+
+void USuraBenchmarkManager::AimAtNearestEnemy() const
+{
+	APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const APawn* NearestEnemy = nullptr;
+	float NearestDistSquared = TNumericLimits<float>::Max();
+
+	for (const FBenchmarkEnemy& Enemy : Enemies)
+	{
+		if (!Enemy.Pawn.IsValid() || Enemy.Pawn->IsHidden())
+			continue;
+
+		const float DistSquared = FVector::DistSquared(ViewLocation, Enemy.Pawn->GetActorLocation());
+
+		if (DistSquared < NearestDistSquared)
+		{
+			NearestDistSquared = DistSquared;
+			NearestEnemy = Enemy.Pawn.Get();
+		}
+	}
+
+	if (NearestEnemy)
+		PlayerController->SetControlRotation(UKismetMathLibrary::FindLookAtRotation(ViewLocation, NearestEnemy->GetActorLocation()));
+}
+
+void USuraBenchmarkManager::UpdateScriptedInput(const FSuraBenchmarkScenario& Scenario, float DeltaTime)
+{
+	const ASuraCharacterPlayer* const Player = Cast<ASuraCharacterPlayer>(GetWorld()->GetFirstPlayerController()->GetPawn());
+	UACWeapon* const Weapon = Player ? Player->GetWeaponSystemComponent()->GetCurrentWeapon() : nullptr;
+
+	if (!Weapon)
+		return;
+
+	const bool bNewCycle = InputTime >= Scenario.HoldTime + Scenario.ReleaseTime;
+
+	if (bNewCycle)
+		InputTime = 0.f;
+
+	const bool bHold = InputTime < Scenario.HoldTime;
+	InputTime += DeltaTime;
+
+	if (!Weapon->HasAmmo())
+	{
+		SetInputHeld(nullptr, false);
+
+		if (bNewCycle)
+			PulseInput(Weapon->ReloadAction);
+
+		return;
+	}
+
+	switch (Weapon->GetWeaponName())
+	{
+	case EWeaponName::WeaponName_Rifle:
+		SetInputHeld(Weapon->FireAction, bHold);
+		break;
+	// held to lock on, the missiles are launched on release
+	case EWeaponName::WeaponName_MissileLauncher:
+		SetInputHeld(Weapon->HoldAction, bHold);
+		break;
+	// held to charge, the penetrating shot is fired on release or at max charge
+	case EWeaponName::WeaponName_RailGun:
+		SetInputHeld(Weapon->ChargeAction, bHold);
+		break;
+	default:
+		if (bNewCycle)
+			PulseInput(Weapon->FireSingleShotAction);
+		break;
+	}
+}
+
+void USuraBenchmarkManager::SetInputHeld(const UInputAction* Action, bool bHeld)
+{
+	UEnhancedInputLocalPlayerSubsystem* const InputSubsystem = GetInputSubsystem(GetWorld());
+
+	if (!InputSubsystem)
+		return;
+
+	if (HeldAction.IsValid() && (!bHeld || HeldAction.Get() != Action))
+	{
+		InputSubsystem->StopContinuousInputInjectionForAction(HeldAction.Get());
+		HeldAction.Reset();
+	}
+
+	if (bHeld && Action && !HeldAction.IsValid())
+	{
+		InputSubsystem->StartContinuousInputInjectionForAction(Action, FInputActionValue(true), {}, {});
+		HeldAction = Action;
+	}
+}
+
+void USuraBenchmarkManager::PulseInput(const UInputAction* Action) const
+{
+	UEnhancedInputLocalPlayerSubsystem* const InputSubsystem = GetInputSubsystem(GetWorld());
+
+	if (InputSubsystem && Action)
+		InputSubsystem->InjectInputForAction(Action, FInputActionValue(true), {}, {});
+}
+
+void USuraBenchmarkManager::RecordFrame(float FrameTime)
+{
+	FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.FrameTime = FrameTime * 1000.f;
+	Sample.GameThreadTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.GCTime = PendingGCTime;
+	Sample.Actors = GetWorld()->GetActorCount();
+	Sample.Objects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+#if !UE_BUILD_SHIPPING
+	Sample.Traces = GSuraNumTraces - LastNumTraces;
+	LastNumTraces = GSuraNumTraces;
+#endif
+
+	PendingGCTime = 0.f;
+}
+
+void USuraBenchmarkManager::WriteScenarioResults(const FSuraBenchmarkScenario& Scenario) const
+{
+#if !UE_BUILD_SHIPPING
+	const FString Directory = FPaths::Combine(FPaths::ProfilingDir(), TEXT("SuraBenchmark"));
+
+	FString Frames = TEXT("Frame,FrameMs,GameThreadMs,GCMs,Traces,Actors,UObjects") LINE_TERMINATOR;
+
+	for (int32 i = 0; i < Samples.Num(); ++i)
+	{
+		const FFrameSample& Sample = Samples[i];
+		Frames += FString::Printf(TEXT("%d,%.3f,%.3f,%.3f,%d,%d,%d") LINE_TERMINATOR, i,
+			Sample.FrameTime, Sample.GameThreadTime, Sample.GCTime, Sample.Traces, Sample.Actors, Sample.Objects);
+	}
+
+	FFileHelper::SaveStringToFile(Frames, *FPaths::Combine(Directory, FString::Printf(TEXT("%s_%s.csv"), *Scenario.Name, *RunName)));
+
+	// one row per metric, so runs of different builds can be lined up by scenario and metric
+	const FString SummaryFilename = FPaths::Combine(Directory, TEXT("Summary.csv"));
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+
+	FString Summary;
+
+	if (!FPaths::FileExists(SummaryFilename))
+		Summary = TEXT("Run,Build,Map,Scenario,Frames,Metric,Median,P95,P99") LINE_TERMINATOR;
+
+	TArray<float> Values;
+	Values.Reserve(Samples.Num());
+
+	auto AddMetric = [&](const TCHAR* Metric, TFunctionRef<float(const FFrameSample&)> GetValue)
+	{
+		Values.Reset();
+
+		for (const FFrameSample& Sample : Samples)
+			Values.Add(GetValue(Sample));
+
+		Values.Sort();
+
+		const float Median = Percentile(Values, 0.5f);
+		const float P95 = Percentile(Values, 0.95f);
+		const float P99 = Percentile(Values, 0.99f);
+
+		Summary += FString::Printf(TEXT("%s,%s,%s,%s,%d,%s,%.3f,%.3f,%.3f") LINE_TERMINATOR,
+			*RunName, FApp::GetBuildVersion(), *MapName, *Scenario.Name, Samples.Num(), Metric, Median, P95, P99);
+
+		UE_LOG(LogTemp, Log, TEXT("Benchmark %-16s %-14s median %10.3f  p95 %10.3f  p99 %10.3f"), *Scenario.Name, Metric, Median, P95, P99);
+	};
+
+	AddMetric(TEXT("FrameMs"), [](const FFrameSample& Sample) { return Sample.FrameTime; });
+	AddMetric(TEXT("GameThreadMs"), [](const FFrameSample& Sample) { return Sample.GameThreadTime; });
+	AddMetric(TEXT("GCMs"), [](const FFrameSample& Sample) { return Sample.GCTime; });
+	AddMetric(TEXT("Traces"), [](const FFrameSample& Sample) { return static_cast<float>(Sample.Traces); });
+	AddMetric(TEXT("Actors"), [](const FFrameSample& Sample) { return static_cast<float>(Sample.Actors); });
+	AddMetric(TEXT("UObjects"), [](const FFrameSample& Sample) { return static_cast<float>(Sample.Objects); });
+
+	FFileHelper::SaveStringToFile(Summary, *SummaryFilename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+#endif
+}
+
+void USuraBenchmarkManager::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void USuraBenchmarkManager::OnPostGarbageCollect()
+{
+	if (GCStartTime > 0.0)
+		PendingGCTime += (FPlatformTime::Seconds() - GCStartTime) * 1000.0;
+
+	GCStartTime = 0.0;
+}
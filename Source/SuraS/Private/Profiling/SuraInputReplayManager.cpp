@@ -0,0 +1,450 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Profiling/SuraInputReplayManager.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
+#include "InputAction.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 RecordingMagic = 0x53495250; // "SIRP"
+
+	constexpr int32 RecordingVersion = 1;
+
+	// only non-zero values are stored, a frame can't hold more than this
+	constexpr int32 MaxValuesPerFrame = MAX_uint8;
+
+#if !UE_BUILD_SHIPPING
+	FAutoConsoleCommandWithWorld StopInputRecordingCommand(
+		TEXT("Sura.StopInputRecording"),
+		TEXT("Writes the input recording started with -SuraRecordInput and stops recording."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			USuraInputReplayManager* const InputReplayManager = World ? World->GetSubsystem<USuraInputReplayManager>() : nullptr;
+
+			if (InputReplayManager && InputReplayManager->IsRecording())
+				InputReplayManager->StopRecording();
+		}));
+#endif
+}
+
+bool USuraInputReplayManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USuraInputReplayManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+#if !UE_BUILD_SHIPPING
+	FString Name;
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("SuraReplayInput="), Name))
+	{
+		Filename = GetRecordingFilename(Name);
+		StartReplay();
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("SuraRecordInput="), Name) || FParse::Param(FCommandLine::Get(), TEXT("SuraRecordInput")))
+	{
+		Filename = GetRecordingFilename(Name.IsEmpty() ? TEXT("Input_") + FDateTime::Now().ToString() : Name);
+		StartRecording();
+	}
+#endif
+}
+
+void USuraInputReplayManager::Deinitialize()
+{
+	if (IsRecording())
+		StopRecording();
+
+	if (IsReplaying())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Input replay of %s stopped at frame %d of %d"), *Filename, FrameIndex, Frames.Num());
+
+		FApp::SetUseFixedTimeStep(bWasUsingFixedTimeStep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+		Mode = EMode::None;
+	}
+
+	Super::Deinitialize();
+}
+
+void USuraInputReplayManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Mode == EMode::None)
+		return;
+
+	if (bStartPending)
+	{
+		const APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+
+		if (!PlayerController || !PlayerController->GetPawn())
+			return;
+
+		bStartPending = false;
+
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+
+		// the first recorded frame is the next one, and that is the one its replayed values are injected for
+		if (IsReplaying())
+		{
+			bWasUsingFixedTimeStep = FApp::UseFixedTimeStep();
+			PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+			FApp::SetUseFixedTimeStep(true);
+
+			FrameIndex = 0;
+			ReplayFrame(FrameIndex);
+		}
+
+		return;
+	}
+
+	if (IsRecording())
+	{
+		RecordFrame();
+		return;
+	}
+
+	// the engine just ran FrameIndex with the values injected on the previous tick
+	if (FrameIndex % RecordedChecksumInterval == 0)
+	{
+		const FRecordedFrame& Frame = Frames[FrameIndex];
+
+		FVector3f Location;
+		++NumChecksums;
+
+		if (ComputeChecksum(Location) != Frame.Checksum)
+		{
+			++NumDivergedChecksums;
+
+			if (FirstDivergedFrame == INDEX_NONE)
+			{
+				FirstDivergedFrame = FrameIndex;
+
+				UE_LOG(LogTemp, Warning, TEXT("Input replay diverged at frame %d, player at %s, recorded at %s"),
+					FrameIndex, *Location.ToString(), *Frame.Location.ToString());
+			}
+		}
+	}
+
+	if (++FrameIndex < Frames.Num())
+		ReplayFrame(FrameIndex);
+	else
+		FinishReplay();
+}
+
+TStatId USuraInputReplayManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USuraInputReplayManager, STATGROUP_Tickables);
+}
+
+void USuraInputReplayManager::StartRecording()
+{
+	Seed = FPlatformTime::Cycles();
+	RecordedChecksumInterval = FMath::Max(ChecksumInterval, 1);
+
+	Frames.Reset();
+	Values.Reset();
+
+	Mode = EMode::Record;
+	bStartPending = true;
+
+	UE_LOG(LogTemp, Log, TEXT("Input recording into %s"), *Filename);
+}
+
+void USuraInputReplayManager::StopRecording()
+{
+	Mode = EMode::None;
+
+	if (SaveRecording())
+		UE_LOG(LogTemp, Log, TEXT("Input recording of %d frames written to %s"), Frames.Num(), *Filename);
+	else
+		UE_LOG(LogTemp, Error, TEXT("Input recording could not be written to %s"), *Filename);
+}
+
+void USuraInputReplayManager::StartReplay()
+{
+	if (!LoadRecording())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Input replay could not read %s"), *Filename);
+		FPlatformMisc::RequestExit(false, TEXT("SuraReplayInput"));
+		return;
+	}
+
+	if (Frames.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Input replay %s has no frames"), *Filename);
+		FPlatformMisc::RequestExit(false, TEXT("SuraReplayInput"));
+		return;
+	}
+
+	NumChecksums = 0;
+	NumDivergedChecksums = 0;
+	FirstDivergedFrame = INDEX_NONE;
+
+	Mode = EMode::Replay;
+	bStartPending = true;
+
+	UE_LOG(LogTemp, Log, TEXT("Input replay of %d frames from %s"), Frames.Num(), *Filename);
+}
+
+void USuraInputReplayManager::FinishReplay()
+{
+	if (NumDivergedChecksums > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Input replay of %s finished, %d of %d checksums diverged, first at frame %d"),
+			*Filename, NumDivergedChecksums, NumChecksums, FirstDivergedFrame);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("Input replay of %s finished, all %d checksums matched"), *Filename, NumChecksums);
+	}
+
+	FApp::SetUseFixedTimeStep(bWasUsingFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+	Mode = EMode::None;
+
+	FPlatformMisc::RequestExit(false, TEXT("SuraReplayInput"));
+}
+
+void USuraInputReplayManager::RecordFrame()
+{
+	const APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+	const UEnhancedPlayerInput* const PlayerInput = PlayerController ? Cast<UEnhancedPlayerInput>(PlayerController->PlayerInput) : nullptr;
+
+	FRecordedFrame& Frame = Frames.AddDefaulted_GetRef();
+	Frame.DeltaTime = FApp::GetDeltaTime();
+	Frame.FirstValue = Values.Num();
+
+	if (PlayerInput)
+	{
+		// the applied mapping contexts map the same action to several keys
+		TArray<const UInputAction*, TInlineAllocator<32>> FrameActions;
+
+		for (const FEnhancedActionKeyMapping& Mapping : PlayerInput->GetEnhancedActionMappings())
+		{
+			if (Mapping.Action)
+				FrameActions.AddUnique(Mapping.Action);
+		}
+
+		for (const UInputAction* Action : FrameActions)
+		{
+			const FInputActionValue Value = PlayerInput->GetActionValue(Action);
+
+			if (!Value.IsNonZero() || Frame.NumValues == MaxValuesPerFrame)
+				continue;
+
+			const uint8 ActionIndex = GetActionIndex(Action);
+
+			if (ActionIndex == MAX_uint8)
+				continue;
+
+			FRecordedValue& RecordedValue = Values.AddDefaulted_GetRef();
+			RecordedValue.Action = ActionIndex;
+			RecordedValue.ValueType = Value.GetValueType();
+			RecordedValue.Value = Value.Get<FVector>();
+
+			++Frame.NumValues;
+		}
+	}
+
+	if ((Frames.Num() - 1) % RecordedChecksumInterval == 0)
+		Frame.Checksum = ComputeChecksum(Frame.Location);
+}
+
+void USuraInputReplayManager::ReplayFrame(int32 Index)
+{
+	const FRecordedFrame& Frame = Frames[Index];
+
+	// picked up by the engine for the frame the values below are processed in
+	FApp::SetFixedDeltaTime(Frame.DeltaTime);
+
+	const APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+	UEnhancedInputLocalPlayerSubsystem* const InputSubsystem = PlayerController ?
+		ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+
+	if (!InputSubsystem)
+		return;
+
+	// the recorded values already went through the mapping modifiers, injecting them only applies the action's own
+	for (int32 i = Frame.FirstValue; i < Frame.FirstValue + Frame.NumValues; ++i)
+	{
+		const FRecordedValue& RecordedValue = Values[i];
+		const UInputAction* const Action = Actions.IsValidIndex(RecordedValue.Action) ? Actions[RecordedValue.Action].Get() : nullptr;
+
+		if (Action)
+			InputSubsystem->InjectInputForAction(Action, FInputActionValue(RecordedValue.ValueType, RecordedValue.Value), {}, {});
+	}
+}
+
+uint8 USuraInputReplayManager::GetActionIndex(const UInputAction* Action)
+{
+	if (const uint8* const ActionIndex = ActionIndices.Find(Action))
+		return *ActionIndex;
+
+	// MAX_uint8 is kept as the invalid index
+	if (Actions.Num() >= MAX_uint8)
+		return MAX_uint8;
+
+	const uint8 ActionIndex = Actions.Add(Action);
+	ActionIndices.Add(Action, ActionIndex);
+
+	return ActionIndex;
+}
+
+uint32 USuraInputReplayManager::ComputeChecksum(FVector3f& OutLocation) const
+{
+	const APlayerController* const PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* const Player = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+	if (!Player)
+	{
+		OutLocation = FVector3f::ZeroVector;
+		return 0;
+	}
+
+	const FVector Location = Player->GetActorLocation();
+	const FVector Velocity = Player->GetVelocity();
+	const FRotator Rotation = PlayerController->GetControlRotation();
+
+	// quantized to a millimeter and a hundredth of a degree, so only real divergence changes it
+	const int32 Quantized[] =
+	{
+		FMath::RoundToInt(Location.X * 10.0), FMath::RoundToInt(Location.Y * 10.0), FMath::RoundToInt(Location.Z * 10.0),
+		FMath::RoundToInt(Velocity.X * 10.0), FMath::RoundToInt(Velocity.Y * 10.0), FMath::RoundToInt(Velocity.Z * 10.0),
+		FMath::RoundToInt(Rotation.Pitch * 100.0), FMath::RoundToInt(Rotation.Yaw * 100.0)
+	};
+
+	OutLocation = FVector3f(Location);
+
+	return FCrc::MemCrc32(Quantized, sizeof(Quantized));
+}
+
+bool USuraInputReplayManager::SaveRecording()
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	SerializeRecording(Writer);
+
+	return !Writer.IsError() && FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool USuraInputReplayManager::LoadRecording()
+{
+	TArray<uint8> Bytes;
+
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+
+	SerializeRecording(Reader);
+
+	return !Reader.IsError();
+}
+
+void USuraInputReplayManager::SerializeRecording(FArchive& Ar)
+{
+	uint32 Magic = RecordingMagic;
+	int32 Version = RecordingVersion;
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != RecordingMagic || Version != RecordingVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	Ar << MapName;
+
+	if (Ar.IsLoading() && MapName != UWorld::RemovePIEPrefix(GetWorld()->GetMapName()))
+		UE_LOG(LogTemp, Warning, TEXT("Input replay %s was recorded on %s"), *Filename, *MapName);
+
+	Ar << Seed << RecordedChecksumInterval;
+
+	RecordedChecksumInterval = FMath::Max(RecordedChecksumInterval, 1);
+
+	TArray<FString> ActionPaths;
+
+	for (const UInputAction* Action : Actions)
+		ActionPaths.Add(Action->GetPathName());
+
+	Ar << ActionPaths;
+
+	if (Ar.IsLoading())
+	{
+		Actions.Reset();
+
+		for (const FString& ActionPath : ActionPaths)
+		{
+			const UInputAction* const Action = LoadObject<UInputAction>(nullptr, *ActionPath);
+
+			if (!Action)
+				UE_LOG(LogTemp, Warning, TEXT("Input replay %s uses %s, which no longer exists"), *Filename, *ActionPath);
+
+			Actions.Add(Action);
+		}
+	}
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+
+	if (Ar.IsLoading())
+	{
+		Frames.SetNum(NumFrames);
+		Values.Reset();
+	}
+
+	for (int32 i = 0; i < NumFrames && !Ar.IsError(); ++i)
+	{
+		FRecordedFrame& Frame = Frames[i];
+		Ar << Frame.DeltaTime << Frame.NumValues;
+
+		if (Ar.IsLoading())
+		{
+			Frame.FirstValue = Values.Num();
+			Values.AddDefaulted(Frame.NumValues);
+		}
+
+		for (int32 j = Frame.FirstValue; j < Frame.FirstValue + Frame.NumValues; ++j)
+		{
+			FRecordedValue& RecordedValue = Values[j];
+
+			uint8 ValueType = static_cast<uint8>(RecordedValue.ValueType);
+			Ar << RecordedValue.Action << ValueType;
+			RecordedValue.ValueType = static_cast<EInputActionValueType>(ValueType);
+
+			// only the axes the value type uses, a bool is stored like an Axis1D
+			for (int32 Axis = 0; Axis < FMath::Clamp<int32>(ValueType, 1, 3); ++Axis)
+			{
+				float Component = RecordedValue.Value[Axis];
+				Ar << Component;
+				RecordedValue.Value[Axis] = Component;
+			}
+		}
+
+		if (i % RecordedChecksumInterval == 0)
+			Ar << Frame.Checksum << Frame.Location;
+	}
+}
+
+FString USuraInputReplayManager::GetRecordingFilename(const FString& Name)
+{
+	return FPaths::Combine(FPaths::ProfilingDir(), TEXT("SuraInput"), Name + TEXT(".surainput"));
+}
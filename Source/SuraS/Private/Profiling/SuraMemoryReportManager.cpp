@@ -0,0 +1,234 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Profiling/SuraMemoryReportManager.h"
+#include "ActorComponents/WeaponSystem/ACWeapon.h"
+#include "ActorComponents/WeaponSystem/SuraProjectile.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Characters/Enemies/AI/EnemyBaseAIController.h"
+#include "Characters/Enemies/Spawner/ObjectPool_Actor.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Components/AudioComponent.h"
+#include "Components/DecalComponent.h"
+#include "Components/WidgetComponent.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "NiagaraComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	double ToMegabytes(int64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+
+#if !UE_BUILD_SHIPPING
+	FAutoConsoleCommandWithWorld MemReportCommand(
+		TEXT("Sura.MemReport"),
+		TEXT("Logs the live gameplay object counts and their estimated memory, current and peak."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (USuraMemoryReportManager* const MemoryReportManager = World ? World->GetSubsystem<USuraMemoryReportManager>() : nullptr)
+				MemoryReportManager->DumpReport();
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs MemSoakCommand(
+		TEXT("Sura.MemSoak"),
+		TEXT("Starts or stops the memory soak test CSV. Sura.MemSoak <SampleInterval> starts it with the given interval in seconds."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			USuraMemoryReportManager* const MemoryReportManager = World ? World->GetSubsystem<USuraMemoryReportManager>() : nullptr;
+
+			if (!MemoryReportManager)
+				return;
+
+			if (!Args.IsEmpty())
+				MemoryReportManager->StartSoakTest(FCString::Atof(*Args[0]));
+			else if (MemoryReportManager->IsSoakTestRunning())
+				MemoryReportManager->StopSoakTest();
+			else
+				MemoryReportManager->StartSoakTest();
+		}));
+#endif
+}
+
+bool USuraMemoryReportManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USuraMemoryReportManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TrackClass(TEXT("Weapons"), UACWeapon::StaticClass());
+	TrackClass(TEXT("Weapons"), UTextureRenderTarget2D::StaticClass());
+	TrackClass(TEXT("Projectiles"), ASuraProjectile::StaticClass());
+	TrackClass(TEXT("FX"), UNiagaraComponent::StaticClass());
+	TrackClass(TEXT("FX"), UDecalComponent::StaticClass());
+	TrackClass(TEXT("FX"), UAudioComponent::StaticClass());
+	TrackClass(TEXT("Enemies"), ASuraCharacterEnemyBase::StaticClass());
+	TrackClass(TEXT("Enemies"), AEnemyBaseAIController::StaticClass());
+	TrackClass(TEXT("UI"), UUserWidget::StaticClass());
+	TrackClass(TEXT("UI"), UWidgetComponent::StaticClass());
+}
+
+void USuraMemoryReportManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("SuraMemSoak")))
+	{
+		float SampleInterval = 0.f;
+		FParse::Value(FCommandLine::Get(), TEXT("SuraMemSoakInterval="), SampleInterval);
+
+		StartSoakTest(SampleInterval);
+	}
+}
+
+void USuraMemoryReportManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bSoakTestRunning)
+		return;
+
+	TimeSinceLastSample += DeltaTime;
+
+	if (TimeSinceLastSample >= SoakSampleInterval)
+	{
+		TimeSinceLastSample = 0.f;
+		Sample();
+		WriteSoakRow();
+	}
+}
+
+TStatId USuraMemoryReportManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USuraMemoryReportManager, STATGROUP_Tickables);
+}
+
+void USuraMemoryReportManager::TrackClass(const TCHAR* Subsystem, UClass* Class)
+{
+	FTrackedClass Tracked;
+	Tracked.Subsystem = Subsystem;
+	Tracked.Class = Class;
+
+	TrackedClasses.Add(Tracked);
+}
+
+void USuraMemoryReportManager::Sample()
+{
+	UWorld* const World = GetWorld();
+
+	TArray<UObject*> Objects;
+
+	for (FTrackedClass& Tracked : TrackedClasses)
+	{
+		Objects.Reset();
+		GetObjectsOfClass(Tracked.Class, Objects, true, RF_ClassDefaultObject | RF_ArchetypeObject, EInternalObjectFlags::Garbage);
+
+		Tracked.Count = 0;
+		Tracked.Bytes = 0;
+
+		for (const UObject* Object : Objects)
+		{
+			// other worlds (e.g. the editor world during PIE) are not ours to report
+			if (Object->GetWorld() != World)
+				continue;
+
+			++Tracked.Count;
+			Tracked.Bytes += Object->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+
+		Tracked.PeakCount = FMath::Max(Tracked.PeakCount, Tracked.Count);
+		Tracked.PeakBytes = FMath::Max(Tracked.PeakBytes, Tracked.Bytes);
+	}
+
+	NumPooledEnemies = 0;
+
+	for (TActorIterator<AObjectPool_Actor> It(World); It; ++It)
+		NumPooledEnemies += It->GetNumPooledObjects();
+
+	PeakPooledEnemies = FMath::Max(PeakPooledEnemies, NumPooledEnemies);
+}
+
+void USuraMemoryReportManager::DumpReport()
+{
+	Sample();
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+
+	UE_LOG(LogTemp, Log, TEXT("SuraS memory report for %s at %.1fs, used physical %.1f MB (peak %.1f MB)"),
+		*UWorld::RemovePIEPrefix(GetWorld()->GetMapName()), GetWorld()->GetTimeSeconds(),
+		ToMegabytes(MemoryStats.UsedPhysical), ToMegabytes(MemoryStats.PeakUsedPhysical));
+
+	// actors include their components, so rows overlap and are not meant to be summed
+	UE_LOG(LogTemp, Log, TEXT("%-12s %-32s %8s %10s %8s %10s"), TEXT("Subsystem"), TEXT("Class"), TEXT("Count"), TEXT("MB"), TEXT("Peak"), TEXT("Peak MB"));
+
+	for (const FTrackedClass& Tracked : TrackedClasses)
+	{
+		UE_LOG(LogTemp, Log, TEXT("%-12s %-32s %8d %10.2f %8d %10.2f"), Tracked.Subsystem, *Tracked.Class->GetName(),
+			Tracked.Count, ToMegabytes(Tracked.Bytes), Tracked.PeakCount, ToMegabytes(Tracked.PeakBytes));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%-12s %-32s %8d %10s %8d"), TEXT("Enemies"), TEXT("(pooled)"), NumPooledEnemies, TEXT("-"), PeakPooledEnemies);
+}
+
+void USuraMemoryReportManager::StartSoakTest(float SampleInterval)
+{
+#if !UE_BUILD_SHIPPING
+	if (SampleInterval > 0.f)
+		SoakSampleInterval = SampleInterval;
+
+	const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+
+	SoakFilename = FPaths::Combine(FPaths::ProfilingDir(),
+		FString::Printf(TEXT("SuraMemorySoak_%s_%s.csv"), *MapName, *FDateTime::Now().ToString()));
+
+	FString Header = TEXT("Time,UsedPhysicalMB,PooledEnemies");
+
+	for (const FTrackedClass& Tracked : TrackedClasses)
+		Header += FString::Printf(TEXT(",%s Count,%s MB"), *Tracked.Class->GetName(), *Tracked.Class->GetName());
+
+	FFileHelper::SaveStringToFile(Header + LINE_TERMINATOR, *SoakFilename);
+
+	bSoakTestRunning = true;
+	TimeSinceLastSample = 0.f;
+
+	// first row right away, so the CSV starts from the level's baseline
+	Sample();
+	WriteSoakRow();
+
+	UE_LOG(LogTemp, Log, TEXT("Memory soak test started, sampling every %.1fs into %s"), SoakSampleInterval, *SoakFilename);
+#endif
+}
+
+void USuraMemoryReportManager::StopSoakTest()
+{
+	if (!bSoakTestRunning)
+		return;
+
+	bSoakTestRunning = false;
+
+	UE_LOG(LogTemp, Log, TEXT("Memory soak test stopped, results in %s"), *SoakFilename);
+}
+
+void USuraMemoryReportManager::WriteSoakRow() const
+{
+#if !UE_BUILD_SHIPPING
+	FString Row = FString::Printf(TEXT("%.1f,%.1f,%d"), GetWorld()->GetTimeSeconds(), ToMegabytes(FPlatformMemory::GetStats().UsedPhysical), NumPooledEnemies);
+
+	for (const FTrackedClass& Tracked : TrackedClasses)
+		Row += FString::Printf(TEXT(",%d,%.3f"), Tracked.Count, ToMegabytes(Tracked.Bytes));
+
+	FFileHelper::SaveStringToFile(Row + LINE_TERMINATOR, *SoakFilename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+#endif
+}
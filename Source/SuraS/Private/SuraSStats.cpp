@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SuraSStats.h"
+
+DEFINE_STAT(STAT_SuraLiveProjectiles);
+DEFINE_STAT(STAT_SuraLiveEnemies);
+DEFINE_STAT(STAT_SuraWidgetsCreated);
+
+DEFINE_STAT(STAT_SuraAITaskExecute);
+
+DEFINE_STAT(STAT_SuraTraces);
+DEFINE_STAT(STAT_SuraProjectilesSpawned);
+DEFINE_STAT(STAT_SuraAITaskExecutions);
+
+LLM_DEFINE_TAG(SuraS_Weapons);
+LLM_DEFINE_TAG(SuraS_Projectiles);
+LLM_DEFINE_TAG(SuraS_FX);
+LLM_DEFINE_TAG(SuraS_Enemies);
+LLM_DEFINE_TAG(SuraS_UI);
+
+#if !UE_BUILD_SHIPPING
+UE_TRACE_CHANNEL_DEFINE(SuraSChannel);
+
+uint64 GSuraNumTraces = 0;
+#endif
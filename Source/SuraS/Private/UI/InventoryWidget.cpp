@@ -213,7 +213,8 @@ void UInventoryWidget::UpdateWeaponUI(FString WeaponNameStr)
             // 이미지 설정
             if (WeaponUI.WeaponImage)
             {
-                WeaponUI.WeaponImage->SetBrushFromTexture(WeaponData->WeaponImage);
+                // 아이콘은 soft reference, 비동기로 로드된 뒤 적용됨
+                WeaponUI.WeaponImage->SetBrushFromSoftTexture(WeaponData->WeaponImage);
 
                 // 무기 소유 여부에 따른 색상 조정
                 if (WeaponData->bIsWeaponOwned)
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/Enemies/EnemyHealthBarLayerWidget.h"
+#include "Characters/Enemies/SuraCharacterEnemyBase.h"
+#include "Blueprint/WidgetTree.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Engine/LocalPlayer.h"
+#include "SceneView.h"
+#include "SuraSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("HealthBarLayer Tick"), STAT_SuraHealthBarLayerTick, STATGROUP_SuraS);
+
+bool UEnemyHealthBarLayerWidget::Initialize()
+{
+	const bool bInitialized = Super::Initialize();
+
+	if (bInitialized && !HealthBarCanvas && WidgetTree && !WidgetTree->RootWidget)
+	{
+		HealthBarCanvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), TEXT("HealthBarCanvas"));
+		WidgetTree->RootWidget = HealthBarCanvas;
+	}
+
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+
+	return bInitialized;
+}
+
+void UEnemyHealthBarLayerWidget::SetHealthBarWidgetClass(TSubclassOf<UEnemyHealthBarWidget> NewHealthBarWidgetClass)
+{
+	HealthBarWidgetClass = NewHealthBarWidgetClass;
+}
+
+void UEnemyHealthBarLayerWidget::ShowHealthBar(ASuraCharacterEnemyBase* Enemy, float Percent)
+{
+	if (!Enemy)
+		return;
+
+	FHealthBarEntry* Entry = FindEntry(Enemy);
+
+	if (!Entry)
+	{
+		UEnemyHealthBarWidget* const Widget = AcquireHealthBarWidget();
+
+		if (!Widget)
+			return;
+
+		Entry = &Entries.AddDefaulted_GetRef();
+		Entry->Enemy = Enemy;
+		Entry->Widget = Widget;
+	}
+
+	Entry->HideTime = GetWorld()->GetTimeSeconds() + DisplayDuration;
+	Entry->Widget->SetHealthBarPercent(Percent);
+	Entry->Widget->PlayFadeAnimtion();
+}
+
+void UEnemyHealthBarLayerWidget::UpdateHealthBar(const ASuraCharacterEnemyBase* Enemy, float Percent)
+{
+	if (FHealthBarEntry* const Entry = FindEntry(Enemy))
+		Entry->Widget->SetHealthBarPercent(Percent);
+}
+
+void UEnemyHealthBarLayerWidget::HideHealthBar(const ASuraCharacterEnemyBase* Enemy)
+{
+	const int32 EntryIndex = Entries.IndexOfByPredicate([Enemy](const FHealthBarEntry& Entry) { return Entry.Enemy.Get() == Enemy; });
+
+	if (EntryIndex != INDEX_NONE)
+	{
+		ReleaseHealthBarWidget(Entries[EntryIndex].Widget);
+		Entries.RemoveAtSwap(EntryIndex);
+	}
+}
+
+void UEnemyHealthBarLayerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (Entries.IsEmpty())
+		return;
+
+	SURAS_SCOPE_CYCLE_COUNTER(STAT_SuraHealthBarLayerTick);
+
+	APlayerController* const PlayerController = GetOwningPlayer();
+	ULocalPlayer* const LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+
+	if (!LocalPlayer || !LocalPlayer->ViewportClient || !PlayerController->PlayerCameraManager)
+		return;
+
+	// one view projection for every bar instead of one deprojection per enemy
+	FSceneViewProjectionData ProjectionData;
+
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+		return;
+
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(this);
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		FHealthBarEntry& Entry = Entries[i];
+		const ASuraCharacterEnemyBase* const Enemy = Entry.Enemy.Get();
+
+		if (!Enemy || Enemy->IsDead() || Enemy->IsHidden() || CurrentTime >= Entry.HideTime)
+		{
+			ReleaseHealthBarWidget(Entry.Widget);
+			Entries.RemoveAtSwap(i);
+			continue;
+		}
+
+		const FVector WorldLocation = Enemy->GetActorLocation() + WorldOffset;
+
+		FVector2D ScreenPosition;
+		const bool bOnScreen = Enemy->ShouldUpdateHealthBar()
+			&& FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPosition)
+			&& ViewRect.Contains(FIntPoint(FMath::TruncToInt(ScreenPosition.X), FMath::TruncToInt(ScreenPosition.Y)));
+
+		// offscreen bars stay assigned until they time out, they just aren't drawn
+		if (!bOnScreen)
+		{
+			if (Entry.Widget->GetVisibility() != ESlateVisibility::Collapsed)
+				Entry.Widget->SetVisibility(ESlateVisibility::Collapsed);
+
+			continue;
+		}
+
+		if (Entry.Widget->GetVisibility() != ESlateVisibility::HitTestInvisible)
+			Entry.Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+
+		const float Distance = FMath::Clamp(FVector::Dist(CameraLocation, WorldLocation), DistanceClamp.X, DistanceClamp.Y);
+		const float Scale = ReferenceDistance / Distance;
+
+		// render transforms only, so moving the bars never invalidates the canvas layout
+		Entry.Widget->SetRenderTransform(FWidgetTransform(ScreenPosition / ViewportScale - HealthBarSize * 0.5f, FVector2D(Scale), FVector2D::ZeroVector, 0.f));
+	}
+}
+
+UEnemyHealthBarLayerWidget::FHealthBarEntry* UEnemyHealthBarLayerWidget::FindEntry(const ASuraCharacterEnemyBase* Enemy)
+{
+	return Entries.FindByPredicate([Enemy](const FHealthBarEntry& Entry) { return Entry.Enemy.Get() == Enemy; });
+}
+
+UEnemyHealthBarWidget* UEnemyHealthBarLayerWidget::AcquireHealthBarWidget()
+{
+	if (!FreeHealthBarWidgets.IsEmpty())
+		return FreeHealthBarWidgets.Pop(EAllowShrinking::No);
+
+	if (!HealthBarWidgetClass || !HealthBarCanvas)
+		return nullptr;
+
+	LLM_SCOPE_BYTAG(SuraS_UI);
+
+	UEnemyHealthBarWidget* const Widget = CreateWidget<UEnemyHealthBarWidget>(this, HealthBarWidgetClass);
+
+	if (!Widget)
+		return nullptr;
+
+	INC_DWORD_STAT(STAT_SuraWidgetsCreated);
+
+	if (HealthBarSize.IsZero())
+		HealthBarSize = Widget->GetHealthBarSize();
+
+	if (UCanvasPanelSlot* const CanvasSlot = HealthBarCanvas->AddChildToCanvas(Widget))
+	{
+		CanvasSlot->SetPosition(FVector2D::ZeroVector);
+		CanvasSlot->SetSize(HealthBarSize);
+	}
+
+	// distance scaling happens around the center of the bar, which NativeTick places on the enemy
+	Widget->SetRenderTransformPivot(FVector2D(0.5f, 0.5f));
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	HealthBarWidgets.Add(Widget);
+
+	return Widget;
+}
+
+void UEnemyHealthBarLayerWidget::ReleaseHealthBarWidget(UEnemyHealthBarWidget* Widget)
+{
+	if (!Widget)
+		return;
+
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	FreeHealthBarWidgets.Add(Widget);
+}
@@ -5,5 +5,18 @@
 
 void UPlayerHitWidget::PlayFadeAnimtion()
 {
+	// the overlay is never clicked, keep it out of hit testing while it's showing
+	SetVisibility(ESlateVisibility::HitTestInvisible);
 	PlayAnimation(FadeInOutAnimation);
 }
+
+void UPlayerHitWidget::OnAnimationFinished_Implementation(const UWidgetAnimation* Animation)
+{
+	Super::OnAnimationFinished_Implementation(Animation);
+
+	// collapsed widgets are skipped by layout and paint until the next hit
+	if (Animation == FadeInOutAnimation)
+	{
+		SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
@@ -46,6 +46,7 @@ public:
 	// Getters
 	float GetHealth() const { return Health; }
 	float GetMaxHealth() const { return MaxHealth; }
+	bool IsDead() const { return bIsDead; }
 
 	FOnDamaged OnDamaged;
 
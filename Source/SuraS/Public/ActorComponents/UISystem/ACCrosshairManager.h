@@ -51,6 +51,10 @@ public:
 	UPROPERTY()
 	UOverlay* CriticalOverlay;
 
+	// 조준 트레이스 주기 (매 프레임 할 필요 없음)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	float TraceInterval = 0.05f;
+
 public:
 	// 크로스 헤어 위젯 초기화
 	void InitializeCrosshairWidget();
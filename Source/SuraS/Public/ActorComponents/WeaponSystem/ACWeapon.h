@@ -11,6 +11,7 @@
 #include "ActorComponents/WeaponSystem/WeaponCamSettingValue.h"
 #include "ActorComponents/WeaponSystem/WeaponInterface.h"
 #include "ActorComponents/WeaponSystem/WeaponRecoilStruct.h"
+#include "ActorComponents/WeaponSystem/WeaponFireKickStruct.h"
 #include "ActorComponents/WeaponSystem/ProjectileSpreadValue.h"
 
 #include "Engine/DataTable.h"
@@ -96,6 +97,8 @@ public:
 
 	void LoadWeaponData(FName WeaponID);
 
+	void ResolveWeaponAssets();
+
 	UFUNCTION(BlueprintCallable, Category = "Weapon")
 	bool AttachWeaponToPlayer(ASuraCharacterPlayerWeapon* TargetCharacter);
 
@@ -175,6 +178,10 @@ protected:
 	void StartFireAnimation(UAnimMontage* CharacterFireAnimation, UAnimMontage* WeaponFireAnimation);
 	void StartAnimation(UAnimMontage* CharacterAnimation, UAnimMontage* WeaponAnimation, float CharacterAnimPlayRate, float WeaponAnimPlayRate);
 	void CancelAnimation(UAnimMontage* CharacterAnimation, UAnimMontage* WeaponAnimation);
+
+	// procedural kick/slide played by the anim instances instead of the fire montages
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Animation")
+	FWeaponFireKickStruct FireKick;
 #pragma endregion
 
 #pragma region Animation/Character
@@ -212,11 +219,16 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
 	USoundBase* FireSound;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	USoundBase* FireLoopSound;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	USoundBase* FireTailSound;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
 	USoundBase* ChargeSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
 	UAudioComponent* ChargeAudioComponent;
 
+	void PlayFireSound();
 	void PlayChargeSound();
 	void StopChargeSound();
 #pragma endregion
@@ -310,8 +322,8 @@ protected:
 
 	void ConsumeAmmo();
 	void ReloadAmmo();
-	bool HasAmmo();
 public:
+	bool HasAmmo() const;
 	void AutoReload();
 	virtual void ReloadingEnd() override; //Legacy
 #pragma endregion
@@ -6,7 +6,7 @@
 #include "Blueprint/UserWidget.h"
 #include "AmmoCounterWidget.generated.h"
 
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class SURAS_API UAmmoCounterWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -16,4 +16,8 @@ public:
 	class UTextBlock* AmmoCount;
 
 	void UpdateAmmoCount(int32 NewAmmoCount);
+
+private:
+	// last displayed count, SetText invalidates the text layout so skip redundant updates
+	int32 DisplayedAmmoCount = INDEX_NONE;
 };
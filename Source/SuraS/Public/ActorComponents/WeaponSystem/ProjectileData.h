@@ -18,14 +18,14 @@ struct SURAS_API FProjectileData : public FTableRowBase
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
 	//UParticleSystem* TrailEffect;
-	UNiagaraSystem* TrailEffect;
+	TSoftObjectPtr<UNiagaraSystem> TrailEffect;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
 	//UParticleSystem* ImpactEffect;
-	UNiagaraSystem* ImpactEffect;
+	TSoftObjectPtr<UNiagaraSystem> ImpactEffect;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
-	UMaterialInterface* HoleDecal;
+	TSoftObjectPtr<UMaterialInterface> HoleDecal;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
 	float DefaultDamage;
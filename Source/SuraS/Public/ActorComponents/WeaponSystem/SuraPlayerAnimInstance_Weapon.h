@@ -6,6 +6,7 @@
 #include "Characters/Player/SuraPlayerEnums.h"
 #include "ActorComponents/WeaponSystem/WeaponStateType.h"
 #include "Animation/AnimInstance.h"
+#include "ActorComponents/WeaponSystem/WeaponFireKickSpring.h"
 #include "SuraPlayerAnimInstance_Weapon.generated.h"
 
 class USuraPlayerBaseState;
@@ -24,6 +25,7 @@ public:
 
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Player")
 	ASuraCharacterPlayerWeapon* Character;
@@ -114,7 +116,20 @@ public:
 
 
 
+	// procedural firing kick, applied additively to the weapon hand in the anim graph
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|FireKick")
+	FVector FireKickLocation;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|FireKick")
+	FRotator FireKickRotation;
+
+private:
+	FWeaponFireKickSpring FireKickSpring;
+
 public:
+	// game thread, consumed by the next anim update
+	void QueueFireKick(const FWeaponFireKickStruct& FireKick, float Roll);
+
 	void UpdateWeapon();
 
 	void SetAimSocket();
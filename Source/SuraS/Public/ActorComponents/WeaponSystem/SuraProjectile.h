@@ -102,6 +102,10 @@ public:
 	ASuraProjectile();
 	void InitializeProjectile(AActor* Owner, UACWeapon* OwnerWeapon, float additonalDamage = 0.f, float AdditionalRadius = 0.f, int32 NumPenetrable = 0);
 	void LoadProjectileData(FName ProjectileID);
+
+	FName GetProjectileDataRowName() const;
+
+	UDataTable* GetProjectileDataTable() const { return ProjectileDataTable; }
 	void SetHomingTarget(bool bIsHoming, AActor* Target);
 	void LaunchProjectile();
 
@@ -127,10 +131,10 @@ protected:
 	bool bShouldUpdateTrailEffect = false;
 	void UpdateTrailEffect();
 
-//protected:
-//	// Called when the game starts or when spawned
-//	virtual void BeginPlay() override;
-//
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
 public:	
 	virtual void Tick(float DeltaTime) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "ActorComponents/WeaponSystem/WeaponFireKickSpring.h"
 #include "SuraWeaponAnimInstance.generated.h"
 
 class UACWeapon;
@@ -14,6 +15,10 @@ UCLASS()
 class SURAS_API USuraWeaponAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
+public:
+	// game thread, consumed by the next anim update
+	void QueueFireKick(const FWeaponFireKickStruct& FireKick, float Roll);
+
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
 	UACWeapon* Weapon;
@@ -21,4 +26,11 @@ protected:
 	virtual void NativeInitializeAnimation() override;
 
 	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+	// applied additively to the slide bone in the anim graph
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|FireKick")
+	float FireSlideOffset;
+
+private:
+	FWeaponFireKickSpring FireKickSpring;
 };
@@ -28,6 +28,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -72,4 +74,6 @@ public:
 
 	EWeaponName GetWeaponName() const { return WeaponName; }
 
+	TSubclassOf<UACWeapon> GetWeaponClass() const { return WeaponClass; }
+
 };
@@ -11,13 +11,14 @@ class ASuraProjectile;
 class UImage;
 class UOverlay;
 
-UCLASS()
+// Updates are pushed by the weapon (spread, hits), so the widget never needs a native tick
+UCLASS(meta = (DisableNativeTick))
 class SURAS_API UWeaponAimUIWidget : public UUserWidget
 {
 	GENERATED_BODY()
 public:
 	virtual void NativeConstruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime);
+	virtual void NativeDestruct() override;
 public:
 	UPROPERTY(meta = (BindWidget))
 	UImage* Dot;
@@ -52,10 +53,29 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float OutCircleSpreadSizeOffset = 10.f;
+
+	// spread changes smaller than this don't resize the circle (and don't invalidate the layout)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MinSpreadChangeToResize = 0.05f;
+
+	float AppliedSpreadValue = 0.f;
 #pragma endregion
 
 #pragma region HitIndicator
 protected:
+	// optional fade animations, when bound they replace the code driven fade below
+	UPROPERTY(Transient, meta = (BindWidgetAnimOptional))
+	class UWidgetAnimation* NormalHitAnimation;
+
+	UPROPERTY(Transient, meta = (BindWidgetAnimOptional))
+	class UWidgetAnimation* CriticalHitAnimation;
+
+	// the code driven fade only runs on this timer while an indicator is showing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float HitIndicatorUpdateInterval = 0.016f;
+
+	FTimerHandle HitIndicatorTimerHandle;
+
 	bool bIsIndicatingNormalHit = false;
 	bool bIsIndicatingCriticalHit = false;
 
@@ -101,5 +121,9 @@ protected:
 	void SetNormalOvelayInvisible();
 
 	void UpdateHitIndicator(float DeltaTime);
+
+	void StartHitIndicatorTimer();
+
+	void OnHitIndicatorTimer();
 #pragma endregion
 };
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "ActorComponents/WeaponSystem/WeaponName.h"
+#include "WeaponAssetStreamingManager.generated.h"
+
+class UACWeapon;
+class ASuraWeaponPickUp;
+
+/**
+ * Streams the soft referenced effects, sounds and camera shakes of weapon and projectile data rows.
+ * Assets are requested when a weapon pick up comes into range or a weapon is equipped,
+ * pick up requests are released again once the pick up is far away.
+ */
+UCLASS(Config = Game)
+class SURAS_API UWeaponAssetStreamingManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FWeaponAssetRequest
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+
+		// callers waiting for Handle to complete, one handle serves all of them
+		TArray<FStreamableDelegate> OnLoadedCallbacks;
+
+		// equipped weapons keep their assets for the rest of the level
+		bool bPinned = false;
+	};
+
+	// keyed by weapon data table row
+	TMap<FName, FWeaponAssetRequest> WeaponRequests;
+
+	TArray<TWeakObjectPtr<ASuraWeaponPickUp>> PickUps;
+
+	float TimeSinceLastUpdate = 0.f;
+
+	// [config]
+	UPROPERTY(Config)
+	float UpdateInterval = 0.5f;
+
+	// pick ups closer than this to the player start streaming their weapon's assets
+	UPROPERTY(Config)
+	float StreamingRange = 3000.f;
+
+	// unpinned assets are released once every pick up of that weapon is further than this
+	UPROPERTY(Config)
+	float ReleaseRange = 4500.f;
+
+	void UpdatePickUps();
+
+	void OnWeaponAssetsLoaded(FName RowName);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	static FName GetWeaponRowName(EWeaponName WeaponName);
+
+	// soft paths of the weapon row and its projectile row, also used to build the level preload manifests.
+	// Weapon provides the tables, WeaponName the row: a class default object is always a rifle
+	static void GatherWeaponAssetPaths(const UACWeapon* Weapon, EWeaponName WeaponName, TArray<FSoftObjectPath>& OutPaths);
+
+	void RegisterPickUp(ASuraWeaponPickUp* PickUp);
+
+	void UnregisterPickUp(ASuraWeaponPickUp* PickUp);
+
+	// Weapon can be a spawned weapon or a class default object. OnLoaded runs once everything is resident,
+	// right away when it already is
+	void RequestWeaponAssets(const UACWeapon* Weapon, EWeaponName WeaponName, bool bPin, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	bool AreWeaponAssetsLoaded(FName RowName) const;
+};
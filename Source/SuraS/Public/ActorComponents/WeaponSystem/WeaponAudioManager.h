@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponAudioManager.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+class USoundConcurrency;
+
+/**
+ * Plays weapon sounds through a small pool of audio components per weapon instead of spawning a voice per shot.
+ * Fire voices share a per owner and a global concurrency group, and rapid shots are merged into the weapon's
+ * looping fire sound (with a tail when the burst ends) when the weapon has one.
+ */
+UCLASS(Config = Game)
+class SURAS_API UWeaponAudioManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FWeaponVoices
+	{
+		TArray<TWeakObjectPtr<UAudioComponent>> FireVoices;
+
+		int32 NextFireVoice = 0;
+
+		TWeakObjectPtr<UAudioComponent> LoopVoice;
+
+		TWeakObjectPtr<UAudioComponent> ChargeVoice;
+
+		TWeakObjectPtr<USoundBase> TailSound;
+
+		double LastShotTime = -1.0;
+
+		int32 RapidShotCount = 0;
+
+		bool bIsLooping = false;
+	};
+
+	TMap<TWeakObjectPtr<USceneComponent>, FWeaponVoices> Weapons;
+
+	UPROPERTY()
+	USoundConcurrency* PerOwnerFireConcurrency;
+
+	UPROPERTY()
+	USoundConcurrency* GlobalFireConcurrency;
+
+	float TimeSinceLastUpdate = 0.f;
+
+	// [config]
+	UPROPERTY(Config)
+	float UpdateInterval = 0.05f;
+
+	// also the size of each weapon's fire voice pool
+	UPROPERTY(Config)
+	int32 MaxFireVoicesPerWeapon = 4;
+
+	UPROPERTY(Config)
+	int32 MaxFireVoicesGlobal = 12;
+
+	// shots closer together than this count as one burst
+	UPROPERTY(Config)
+	float BurstShotInterval = 0.15f;
+
+	// consecutive rapid shots before switching to the loop
+	UPROPERTY(Config)
+	int32 BurstStartShots = 3;
+
+	UPROPERTY(Config)
+	float LoopFadeOutTime = 0.05f;
+
+	UAudioComponent* CreateVoice(USceneComponent* Weapon, FName SocketName, bool bUseFireConcurrency) const;
+
+	UAudioComponent* AcquireFireVoice(USceneComponent* Weapon, FWeaponVoices& Voices, FName SocketName);
+
+	void StopBurst(USceneComponent* Weapon, FWeaponVoices& Voices, FName SocketName);
+
+	void UpdateVoices();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// LoopSound and TailSound are optional, without them every shot plays FireSound
+	void PlayFireSound(USceneComponent* Weapon, USoundBase* FireSound, USoundBase* LoopSound = nullptr, USoundBase* TailSound = nullptr, FName SocketName = TEXT("Muzzle"));
+
+	// reuses the weapon's charge voice, returns it so the caller can stop it
+	UAudioComponent* PlayChargeSound(USceneComponent* Weapon, USoundBase* ChargeSound, FName SocketName = TEXT("Muzzle"));
+
+	void StopWeaponSounds(USceneComponent* Weapon);
+};
@@ -6,11 +6,13 @@
 #include "ActorComponents/WeaponSystem/WeaponName.h"
 #include "ActorComponents/WeaponSystem/ProjectileType.h"
 #include "ActorComponents/WeaponSystem/WeaponRecoilStruct.h"
+#include "ActorComponents/WeaponSystem/WeaponFireKickStruct.h"
 #include "ActorComponents/WeaponSystem/WeaponCameraShakeBase.h"
 #include "ActorComponents/WeaponSystem/ProjectileSpreadValue.h"
 #include "NiagaraSystem.h"
 #include "WeaponData.generated.h"
 
+// effects, sounds, icons and camera shakes are soft references, they are streamed in by UWeaponAssetStreamingManager
 USTRUCT(BlueprintType)
 struct SURAS_API FWeaponData : public FTableRowBase
 {
@@ -24,9 +26,9 @@ struct SURAS_API FWeaponData : public FTableRowBase
 	
 	//-----------------------------------------------------------------
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
-	UNiagaraSystem* FireEffect;
+	TSoftObjectPtr<UNiagaraSystem> FireEffect;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
-	UNiagaraSystem* ChargeEffect;
+	TSoftObjectPtr<UNiagaraSystem> ChargeEffect;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
 	FVector ChargeEffectLocation;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
@@ -35,14 +37,20 @@ struct SURAS_API FWeaponData : public FTableRowBase
 	FVector ChargeEffenctScale = { 1.f, 1.f, 1.f };
 	//-----------------------------------------------------------------
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
-	USoundBase* FireSound;
+	TSoftObjectPtr<USoundBase> FireSound;
+	// optional, rapid shots are merged into this loop
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
-	USoundBase* ChargeSound;
+	TSoftObjectPtr<USoundBase> FireLoopSound;
+	// optional, played when a looping burst ends
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	TSoftObjectPtr<USoundBase> FireTailSound;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+	TSoftObjectPtr<USoundBase> ChargeSound;
 	//-----------------------------------------------------------------
 
 	/** Start Suhyeon  **/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* WeaponImage; // 총기 이미지
+	TSoftObjectPtr<UTexture2D> WeaponImage; // 총기 이미지
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bIsWeaponOwned; // 총기 소유 불값
@@ -77,12 +85,15 @@ struct SURAS_API FWeaponData : public FTableRowBase
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Recoil")
 	FWeaponRecoilStruct ZoomRecoil;
 	//-----------------------------------------------------------------
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FireKick")
+	FWeaponFireKickStruct FireKick;
+	//-----------------------------------------------------------------
 	UPROPERTY(EditAnywhere, BlueprintreadWrite, Category = "CameraShake")
-	TSubclassOf<UWeaponCameraShakeBase> DefaultCameraShakeClass;
+	TSoftClassPtr<UWeaponCameraShakeBase> DefaultCameraShakeClass;
 	UPROPERTY(EditAnywhere, BlueprintreadWrite, Category = "CameraShake")
-	TSubclassOf<UWeaponCameraShakeBase> ZoomCameraShakeClass;
+	TSoftClassPtr<UWeaponCameraShakeBase> ZoomCameraShakeClass;
 	UPROPERTY(EditAnywhere, BlueprintreadWrite, Category = "CameraShake")
-	TSubclassOf<UWeaponCameraShakeBase> ChargingCameraShakeClass;
+	TSoftClassPtr<UWeaponCameraShakeBase> ChargingCameraShakeClass;
 	//-----------------------------------------------------------------
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting")
 	float MissileLaunchDelay = 0.2;
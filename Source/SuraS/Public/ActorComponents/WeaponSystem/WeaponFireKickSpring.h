@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "ActorComponents/WeaponSystem/WeaponFireKickStruct.h"
+
+/**
+ * Damped spring that turns queued shot events into a firing kick pose.
+ * QueueShot is called on the game thread, Update on the anim worker thread.
+ */
+class SURAS_API FWeaponFireKickSpring
+{
+public:
+	void QueueShot(const FWeaponFireKickStruct& Settings, float Roll);
+
+	void Update(float DeltaTime);
+
+	FVector GetKickLocation() const { return FVector(-Position.X, 0.f, 0.f); }
+	FRotator GetKickRotation() const { return FRotator(Position.Y, 0.f, Position.Z); }
+	float GetSlideOffset() const { return -Slide; }
+
+private:
+	struct FShot
+	{
+		FWeaponFireKickStruct Settings;
+		float Roll = 0.f;
+	};
+
+	// shots fired between two anim updates, more than this in one frame adds nothing visible
+	static constexpr uint32 MaxPendingShots = 8;
+
+	// single producer/single consumer ring, queueing a shot never allocates
+	FShot PendingShots[MaxPendingShots];
+	std::atomic<uint32> PendingWrite{ 0 };
+	std::atomic<uint32> PendingRead{ 0 };
+
+	// settings of the last shot, the spring keeps settling with them
+	FWeaponFireKickStruct Settings;
+
+	// X back, Y pitch, Z roll
+	FVector Position = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+
+	float Slide = 0.f;
+	float SlideVelocity = 0.f;
+};
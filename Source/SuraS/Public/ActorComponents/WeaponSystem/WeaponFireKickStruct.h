@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponFireKickStruct.generated.h"
+
+/**
+ * Per-weapon parameters for the procedural firing kick (arms kick/recoil pose and weapon slide).
+ * Amounts are the peak offsets of one shot, the spring settles back on its own.
+ */
+USTRUCT(BlueprintType)
+struct SURAS_API FWeaponFireKickStruct
+{
+	GENERATED_BODY()
+public:
+	// false plays the fire montages every shot. only turn it on for weapons whose anim graphs
+	// apply FireKickLocation/FireKickRotation/FireSlideOffset, the montages are skipped otherwise
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bUseProceduralFireKick = false;
+
+	// cm, pushed back along the weapon
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float KickBack = 3.f;
+
+	// degrees of muzzle climb
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float KickPitch = 4.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float KickRollMin = -2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float KickRollMax = 2.f;
+
+	// cm, slide/bolt travel on the weapon mesh
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SlideBack = 2.f;
+
+	// higher is snappier
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1.0"))
+	float Stiffness = 400.f;
+
+	// 2 * sqrt(Stiffness) is critically damped, lower overshoots
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Damping = 24.f;
+};
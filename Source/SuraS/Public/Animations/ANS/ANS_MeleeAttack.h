@@ -4,23 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimNotifies/AnimNotifyState.h"
-#include "Characters/Enemies/SuraCharacterEnemyBase.h"
 #include "ANS_MeleeAttack.generated.h"
 
 /**
- * 
+ * Opens a melee attack window for the duration of the notify. Hits are resolved by UEnemyMeleeHitResolver,
+ * this object is shared by every instance playing the montage so it keeps no per-instance state.
  */
 UCLASS()
 class SURAS_API UANS_MeleeAttack : public UAnimNotifyState
 {
 	GENERATED_BODY()
 
-	ASuraCharacterEnemyBase* Enemy;
-
-	FORCEINLINE ASuraCharacterEnemyBase* GetEnemyChar() const { return Enemy; }
-
-	bool bCanInflictDamage = true;
-
 public:
 	UPROPERTY(EditAnywhere)
 	float AdditionalDamageAmount;
@@ -32,6 +26,5 @@ public:
 	float AttackRadius;
 
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EvetnRef) override;
-	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EvetnRef) override;
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EvetnRef) override;
 };
@@ -6,6 +6,7 @@
 #include "AIController.h"
 #include "Perception/AIPerceptionTypes.h"
 #include "Enumerations/Enemies/EEnemyState.h"
+#include "Structures/Enemies/EnemyLODTierSettings.h"
 #include "EnemyBaseAIController.generated.h"
 
 /**
@@ -36,4 +37,9 @@ public:
 	EEnemyState GetCurrentState() const { return CurrentState; }
 
 	void UpdateCurrentState(EEnemyState NewState);
+
+	// picks up where a dehydrated crowd entity left off
+	void ResumeState(EEnemyState State, AActor* AttackTarget);
+
+	void ApplyLODTierSettings(const FEnemyLODTierSettings& Settings);
 };
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyNavQueryManager.generated.h"
+
+DECLARE_DELEGATE_TwoParams(FOnNavQueryFinished, bool /* bSuccess */, const FVector& /* Location */);
+
+// node memory of the behavior tree tasks waiting on a nav query
+struct FBTNavQueryTaskMemory
+{
+	uint32 RequestId = 0;
+};
+
+/**
+ * Collects the navigation queries of all enemies and answers them in batches on its own tick,
+ * so behavior tree tasks wait (latent) instead of querying the navmesh one by one.
+ * Random location queries are capped per tick, target location queries are resolved once per
+ * target and shared by every enemy chasing it.
+ */
+UCLASS(Config = Game)
+class SURAS_API UEnemyNavQueryManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FRandomLocationRequest
+	{
+		uint32 RequestId;
+		FVector Origin;
+		float Radius;
+		FOnNavQueryFinished OnFinished;
+	};
+
+	struct FTargetLocationRequest
+	{
+		uint32 RequestId;
+		TWeakObjectPtr<const AActor> Target;
+		FOnNavQueryFinished OnFinished;
+	};
+
+	// navmesh location handed out for a target, refreshed at most every TargetRefreshInterval
+	struct FSharedTargetLocation
+	{
+		FVector Location = FVector::ZeroVector;
+		float LastUpdateTime = -1.f;
+		bool bIsValid = false;
+	};
+
+	TArray<FRandomLocationRequest> RandomLocationRequests;
+
+	TArray<FTargetLocationRequest> TargetLocationRequests;
+
+	TMap<TWeakObjectPtr<const AActor>, FSharedTargetLocation> SharedTargetLocations;
+
+	uint32 LastRequestId = 0;
+
+	// [config]
+	// random location queries answered per tick, the rest wait for the next ticks
+	UPROPERTY(Config)
+	int32 MaxRandomLocationQueriesPerTick = 16;
+
+	// seconds a shared target location is reused before it is projected again
+	UPROPERTY(Config)
+	float TargetRefreshInterval = 0.2f;
+
+	// the shared target location only moves once the target moved this far (cm),
+	// so chasers don't repath for every small step of the player
+	UPROPERTY(Config)
+	float TargetMoveThreshold = 150.f;
+
+	void ProcessRandomLocationRequests(class UNavigationSystemV1* NavSystem);
+
+	void ProcessTargetLocationRequests(class UNavigationSystemV1* NavSystem);
+
+	const FSharedTargetLocation& UpdateSharedTargetLocation(class UNavigationSystemV1* NavSystem, const AActor* Target);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	uint32 RequestRandomLocation(const FVector& Origin, float Radius, FOnNavQueryFinished OnFinished);
+
+	uint32 RequestTargetLocation(const AActor* Target, FOnNavQueryFinished OnFinished);
+
+	// drops a pending request, its delegate won't be called
+	void CancelRequest(uint32 RequestId);
+
+	FORCEINLINE int32 GetNumPendingRequests() const { return RandomLocationRequests.Num() + TargetLocationRequests.Num(); }
+};
@@ -13,8 +13,14 @@ UCLASS()
 class SURAS_API UBTT_UpdateAttackTargetLocation : public UBTTask_BlackboardBase
 {
 	GENERATED_BODY()
+
+	// answered by UEnemyNavQueryManager, the task stays in progress until then
+	void OnQueryFinished(bool bSuccess, const FVector& Location, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 	
 public:
 	explicit UBTT_UpdateAttackTargetLocation(FObjectInitializer const& ObjectInitializer);
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
 };
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyMeleeHitResolver.generated.h"
+
+class ASuraCharacterEnemyBase;
+
+/**
+ * Resolves every active enemy melee attack window against the player's capsule at a fixed rate.
+ * Windows are opened/closed by UANS_MeleeAttack per playing instance and each one can hit at most once.
+ * Opening and closing windows is guarded, so it is safe to call from animation worker threads.
+ */
+UCLASS(Config = Game)
+class SURAS_API UEnemyMeleeHitResolver : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FMeleeAttackWindow
+	{
+		// notify that opened the window, paired with the enemy to find it again on close
+		const UObject* Source = nullptr;
+
+		TWeakObjectPtr<ASuraCharacterEnemyBase> Enemy;
+
+		float AttackRange = 0.f;
+
+		float AttackRadius = 0.f;
+
+		float AdditionalDamageAmount = 0.f;
+
+		bool bHasHit = false;
+
+		bool bHasBeenEvaluated = false;
+
+		bool bIsClosed = false;
+	};
+
+	TArray<FMeleeAttackWindow> Windows;
+
+	FCriticalSection WindowsLock;
+
+	float TimeSinceLastEvaluation = 0.f;
+
+	// [config]
+	// seconds between two evaluations of the open windows
+	UPROPERTY(Config)
+	float EvaluationInterval = 0.033f;
+
+	void EvaluateWindows();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void OpenAttackWindow(const UObject* Source, ASuraCharacterEnemyBase* Enemy, float AttackRange, float AttackRadius, float AdditionalDamageAmount);
+
+	// a window closed before it was ever evaluated still gets one last evaluation
+	void CloseAttackWindow(const UObject* Source, const AActor* Enemy);
+
+	// drops every window of the enemy without a last evaluation, e.g. when it goes back to its pool mid-attack
+	void RemoveAttackWindows(const AActor* Enemy);
+};
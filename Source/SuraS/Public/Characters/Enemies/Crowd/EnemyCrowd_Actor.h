@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Interfaces/Damageable.h"
+#include "Structures/DamageData.h"
+#include "Structures/Enemies/EnemyCrowdEntity.h"
+#include "Structures/Enemies/EnemyCrowdType.h"
+#include "EnemyCrowd_Actor.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * Simulates large numbers of far-away enemies as plain data rendered through instanced meshes.
+ * Entities close to the player (or shot at) are hydrated into pooled full characters
+ * and dehydrated back once they move away again, keeping their health and state.
+ */
+UCLASS()
+class SURAS_API AEnemyCrowd_Actor : public AActor, public IDamageable
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UInstancedStaticMeshComponent*> InstanceComps; // one per crowd type
+
+	UPROPERTY()
+	TArray<FEnemyCrowdEntity> Entities;
+
+	// per crowd type, instance index -> entity index
+	TArray<TArray<int32>> InstanceToEntity;
+
+	// per crowd type, transforms pushed to the instanced mesh in one batch every tick
+	TArray<TArray<FTransform>> InstanceTransforms;
+
+	TArray<int32> HydratedEntityIndices;
+
+	// damage received through IDamageable, resolved to an instance by the following hit event
+	TArray<FDamageData> PendingDamage;
+
+	const AActor* PendingDamageCauser = nullptr;
+
+	int32 NavQueryCursor = 0;
+
+	void SpawnEntities();
+
+	void UpdateMovement(float DeltaSeconds, const FVector& PlayerLocation);
+
+	void UpdateNavigation();
+
+	void UpdateHydration(const FVector& PlayerLocation);
+
+	void UpdateInstances();
+
+	bool HydrateEntity(int32 EntityIndex);
+
+	void DehydrateEntity(int32 EntityIndex);
+
+	UFUNCTION()
+	void OnInstanceHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(EditAnywhere, Category = "Crowd")
+	TArray<FEnemyCrowdType> CrowdTypes;
+
+	// entities are scattered on the navmesh within this radius around the actor
+	UPROPERTY(EditAnywhere, Category = "Crowd")
+	float SpawnRadius = 5000.f;
+
+	// entities closer than this to the player become full characters
+	UPROPERTY(EditAnywhere, Category = "Crowd|Hydration")
+	float HydrateDistance = 2500.f;
+
+	// full characters farther than this go back to the crowd, kept above HydrateDistance to avoid flip-flopping
+	UPROPERTY(EditAnywhere, Category = "Crowd|Hydration")
+	float DehydrateDistance = 3500.f;
+
+	UPROPERTY(EditAnywhere, Category = "Crowd|Hydration")
+	int32 MaxHydratedEntities = 30;
+
+	// spreads the cost of spawning/teleporting characters over several frames
+	UPROPERTY(EditAnywhere, Category = "Crowd|Hydration")
+	int32 MaxHydrationsPerTick = 2;
+
+	// entities within this distance walk towards the player, the others roam
+	UPROPERTY(EditAnywhere, Category = "Crowd|Movement")
+	float ChaseDistance = 5000.f;
+
+	UPROPERTY(EditAnywhere, Category = "Crowd|Movement")
+	float RoamRadius = 1500.f;
+
+	UPROPERTY(EditAnywhere, Category = "Crowd|Movement")
+	float AcceptanceRadius = 100.f;
+
+	// navmesh queries are spread over frames, this caps how many run per tick regardless of the crowd size
+	UPROPERTY(EditAnywhere, Category = "Crowd|Movement")
+	int32 MaxNavQueriesPerTick = 64;
+
+	// lets projectiles hit the instances, which hydrates the entity that was hit.
+	// the body of every moving instance is moved along with it, which scales with the crowd size, so it is off by default
+	UPROPERTY(EditAnywhere, Category = "Crowd|Rendering")
+	bool bInstancesBlockProjectiles = false;
+
+public:
+	AEnemyCrowd_Actor();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual bool TakeDamage(const FDamageData& DamageData, const AActor* DamageCauser) override;
+
+	FORCEINLINE int32 GetNumEntities() const { return Entities.Num(); }
+
+	FORCEINLINE int32 GetNumHydratedEntities() const { return HydratedEntityIndices.Num(); }
+};
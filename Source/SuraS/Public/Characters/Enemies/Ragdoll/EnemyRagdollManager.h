@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyRagdollManager.generated.h"
+
+class ASuraCharacterEnemyBase;
+
+/**
+ * Keeps the number of simulating enemy ragdolls under a global cap.
+ * Settled ragdolls are put to sleep and then frozen in their last pose, the oldest ones are frozen
+ * early to make room, and when no room can be made the enemy falls back to its death animation.
+ */
+UCLASS(Config = Game)
+class SURAS_API UEnemyRagdollManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FActiveRagdoll
+	{
+		TWeakObjectPtr<ASuraCharacterEnemyBase> Enemy;
+
+		float StartTime = 0.f;
+
+		// time the bodies were put to sleep, negative while still moving
+		float SleepTime = -1.f;
+	};
+
+	// oldest first
+	TArray<FActiveRagdoll> ActiveRagdolls;
+
+	float TimeSinceLastUpdate = 0.f;
+
+	// [config]
+	// seconds between two checks of the active ragdolls
+	UPROPERTY(Config)
+	float UpdateInterval = 0.1f;
+
+	UPROPERTY(Config)
+	int32 MaxSimulatingRagdolls = 8;
+
+	// a ragdoll younger than this is never frozen to make room, the new one uses the death animation instead
+	UPROPERTY(Config)
+	float MinSimulationTime = 0.5f;
+
+	UPROPERTY(Config)
+	float MaxSimulationTime = 3.f;
+
+	// root body speed (cm/s) under which a ragdoll counts as settled
+	UPROPERTY(Config)
+	float SettledSpeed = 5.f;
+
+	// seconds a settled ragdoll sleeps before it is frozen
+	UPROPERTY(Config)
+	float SleepToFreezeDelay = 0.5f;
+
+	void UpdateRagdolls();
+
+	void FreezeRagdoll(ASuraCharacterEnemyBase* Enemy);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// starts the ragdoll if the budget allows it, returns false when the enemy should play its death animation instead
+	bool RequestRagdoll(ASuraCharacterEnemyBase* Enemy);
+
+	// stops simulating (or unfreezes) the enemy's mesh, e.g. when it goes back to its pool
+	void ReleaseRagdoll(ASuraCharacterEnemyBase* Enemy);
+
+	FORCEINLINE int32 GetNumSimulatingRagdolls() const { return ActiveRagdolls.Num(); }
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Enumerations/Enemies/EEnemyLODTier.h"
+#include "EnemySignificanceManager.generated.h"
+
+class ASuraCharacterEnemyBase;
+
+/**
+ * Ranks registered enemies by distance to the player camera, whether they were rendered recently
+ * and whether they are engaging the player, then assigns each one an LOD tier.
+ * The enemy applies the tick budget of its tier itself (see ASuraCharacterEnemyBase::ApplyLODTier).
+ */
+UCLASS(Config = Game)
+class SURAS_API UEnemySignificanceManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<ASuraCharacterEnemyBase*> Enemies;
+
+	float TimeSinceLastUpdate = 0.f;
+
+	// [config]
+	// seconds between two significance passes
+	UPROPERTY(Config)
+	float UpdateInterval = 0.25f;
+
+	// tier boundaries on the weighted distance (cm)
+	UPROPERTY(Config)
+	float MediumTierDistance = 1500.f;
+
+	UPROPERTY(Config)
+	float LowTierDistance = 3000.f;
+
+	UPROPERTY(Config)
+	float DormantTierDistance = 6000.f;
+
+	// an enemy only drops to a farther tier once it is this fraction beyond the boundary
+	UPROPERTY(Config)
+	float HysteresisRatio = 0.15f;
+
+	// enemies not rendered recently are treated as if they were this much farther away
+	UPROPERTY(Config)
+	float NotRenderedDistanceScale = 1.5f;
+
+	// enemies engaging the player are treated as if they were this much closer
+	UPROPERTY(Config)
+	float AttackingDistanceScale = 0.5f;
+
+	// the closest N enemies may run at High, the rest are capped to Medium
+	UPROPERTY(Config)
+	int32 MaxHighTierEnemies = 12;
+
+	void UpdateSignificance();
+
+	float CalculateWeightedDistance(const ASuraCharacterEnemyBase* Enemy, const FVector& ViewLocation) const;
+
+	EEnemyLODTier CalculateTier(float WeightedDistance, EEnemyLODTier CurrentTier) const;
+
+	float GetTierBoundary(EEnemyLODTier Tier) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterEnemy(ASuraCharacterEnemyBase* Enemy);
+
+	void UnregisterEnemy(ASuraCharacterEnemyBase* Enemy);
+
+	FORCEINLINE int32 GetNumRegisteredEnemies() const { return Enemies.Num(); }
+};
@@ -22,15 +22,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ObjectPool")
 		APawn* SpawnPooledObject();
 
+	// reuses a hidden pawn or spawns a new one at the given transform
+	APawn* AcquirePooledObject(const FVector& Location, const FRotator& Rotation);
+
+	// hides the pawn and stops its logic so it can be acquired again
+	void ReleasePooledObject(APawn* PoolableActor);
+
 	UFUNCTION()
 		void SpawnWrapper();
 
+	// every pawn the pool owns, hidden ones included
+	FORCEINLINE int32 GetNumPooledObjects() const { return ObjectPool.Num(); }
+
 	UPROPERTY(EditAnywhere, Category = "ObjectPool")
 		TSubclassOf<class APawn> PooledObjectSubclass;
 
 	UPROPERTY(EditAnywhere, Category = "ObjectPool")
 		int PoolSize = 5;
 
+	// pools only feeding other systems (e.g. the enemy crowd) don't spawn on their own
+	UPROPERTY(EditAnywhere, Category = "ObjectPool")
+		bool bSpawnOnTimer = true;
+
 protected:
 	virtual void BeginPlay() override;
 
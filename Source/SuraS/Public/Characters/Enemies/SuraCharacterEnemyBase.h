@@ -12,7 +12,8 @@
 #include "Interfaces/Enemies/EnemyActions.h"
 
 #include "ActorComponents/DamageComponent/ACDamageSystem.h"
-#include "Components/WidgetComponent.h"
+#include "Enumerations/Enemies/EEnemyLODTier.h"
+#include "Structures/Enemies/EnemyLODTierSettings.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "SuraCharacterEnemyBase.generated.h"
 
@@ -31,12 +32,23 @@ class SURAS_API ASuraCharacterEnemyBase : public ASuraCharacterBase, public IDam
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Actor Components", meta = (AllowPrivateAccess = "true"))
 	UACDamageSystem* DamageSystemComp;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
-	UWidgetComponent* HealthBarWidget;
+	EEnemyLODTier LODTier = EEnemyLODTier::High;
 
-	FVector2D HealthBarWidgetSize;
+	bool bUpdateHealthBar = true;
 
-	FTimerHandle HideHealthBarHandle;
+	FTransform MeshRelativeTransform;
+
+	FName MeshCollisionProfileName;
+
+	FName CapsuleCollisionProfileName;
+
+	// handed out by a pool and not returned yet, what STAT_SuraLiveEnemies counts
+	bool bIsAcquiredFromPool = false;
+
+	void SetAcquiredFromPool(bool bAcquired);
+
+	// the player's HUD layer drawing every enemy health bar
+	class UEnemyHealthBarLayerWidget* GetHealthBarLayer() const;
 
 protected:
 	// [protected variables]
@@ -48,8 +60,6 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	virtual void Tick(float DeltaSeconds) override;
-
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (AllowPrivateAccess = "true"))
@@ -61,6 +71,10 @@ protected:
 
 	virtual void UpdateHealthBarValue();
 
+	// tick budget per LOD tier, applied when the significance manager changes the tier
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "LOD")
+	TMap<EEnemyLODTier, FEnemyLODTierSettings> LODTierSettings;
+
 public:
 	ASuraCharacterEnemyBase();
 
@@ -73,9 +87,6 @@ public:
 	// player controller getter
 	FORCEINLINE APlayerController* GetPlayerController() const { return PlayerController; }
 
-	// widget size getter
-	FORCEINLINE FVector2D GetHealthBarWidgetSize() const { return HealthBarWidgetSize; }
-
 	// damage system comp getter
 	FORCEINLINE UACDamageSystem* GetDamageSystemComp() const { return DamageSystemComp; }
 
@@ -87,6 +98,23 @@ public:
 
 	FORCEINLINE FName GetEnemyType() const { return EnemyType; }
 
+	FORCEINLINE EEnemyLODTier GetLODTier() const { return LODTier; }
+
+	FORCEINLINE bool ShouldUpdateHealthBar() const { return bUpdateHealthBar; }
+
+	bool IsDead() const { return DamageSystemComp && DamageSystemComp->IsDead(); }
+
+	void ApplyLODTier(EEnemyLODTier NewTier);
+
+	// stops the ragdoll, restores mesh/capsule/health and hides the enemy so its pool can reuse it
+	void ReturnToPool();
+
+	// called by the pool handing this enemy out
+	void OnAcquiredFromPool() { SetAcquiredFromPool(true); }
+
+	// overrides the current health, used when a crowd entity hands its state over to this character
+	void RestoreHealth(float NewHealth);
+
 	void SetUpAIController(AEnemyBaseAIController* const NewAIController); // const ptr: the ptr address can't be changed
 
 	virtual bool TakeDamage(const FDamageData& DamageData, const AActor* DamageCauser) override;
@@ -43,6 +43,9 @@ class SURAS_API ASuraCharacterPlayer : public ASuraCharacterBase, public IDamage
 	TSubclassOf<class UUserWidget> HitEffectWidgetClass;
 	UPlayerHitWidget* HitEffectWidget;
 
+	TSubclassOf<class UEnemyHealthBarWidget> EnemyHealthBarWidgetClass;
+	class UEnemyHealthBarLayerWidget* EnemyHealthBarLayer;
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "WeaponSystem")
 	UWeaponSystemComponent* WeaponSystem;
@@ -328,6 +331,8 @@ public:
 
 	UWeaponSystemComponent* GetWeaponSystemComponent() const { return WeaponSystem; }
 
+	UEnemyHealthBarLayerWidget* GetEnemyHealthBarLayer() const { return EnemyHealthBarLayer; }
+
 };
 
 
@@ -0,0 +1,12 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+UENUM(BlueprintType)
+enum class EEnemyLODTier : uint8
+{
+	High UMETA(DisplayName = "High"),
+	Medium UMETA(DisplayName = "Medium"),
+	Low UMETA(DisplayName = "Low"),
+	Dormant UMETA(DisplayName = "Dormant")
+};
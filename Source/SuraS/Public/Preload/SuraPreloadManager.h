@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "SuraPreloadManager.generated.h"
+
+class USuraPreloadManifest;
+
+DECLARE_MULTICAST_DELEGATE(FOnPreloadComplete);
+
+/**
+ * Loads the level's preload manifest when the level starts and warms up what it loaded
+ * (niagara systems are spawned once out of sight, sounds are primed), so first use during gameplay doesn't hitch.
+ * Anything still loaded on demand afterwards is collected into a hitch report written when the level ends.
+ */
+UCLASS(Config = Game)
+class SURAS_API USuraPreloadManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FLazyLoad
+	{
+		FString AssetName;
+
+		float Time = 0.f;
+
+		bool bSynchronous = false;
+	};
+
+	UPROPERTY()
+	USuraPreloadManifest* Manifest;
+
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	bool bPreloadComplete = false;
+
+	TArray<FLazyLoad> LazyLoads;
+
+	FDelegateHandle SyncLoadDelegateHandle;
+
+	// [config]
+	// manifests are looked up as <ManifestDirectory>/PM_<MapName>
+	UPROPERTY(Config)
+	FString ManifestDirectory = TEXT("/Game/Preload");
+
+	// seconds the level start may block on the preload, the rest finishes asynchronously
+	UPROPERTY(Config)
+	float MaxBlockingPreloadTime = 5.f;
+
+	UPROPERTY(Config)
+	bool bWriteHitchReport = true;
+
+	void OnPreloadLoaded();
+
+	void WarmUp();
+
+	void OnSyncLoadPackage(const FString& PackageName);
+
+	void WriteHitchReport() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	static FString GetManifestObjectPath(const FString& Directory, const UWorld* World);
+
+	FORCEINLINE const FString& GetManifestDirectory() const { return ManifestDirectory; }
+
+	// called by systems that stream assets on demand, only recorded once the preload is done
+	void ReportLazyLoad(const FSoftObjectPath& AssetPath);
+
+	FORCEINLINE bool IsPreloadComplete() const { return bPreloadComplete; }
+
+	FOnPreloadComplete OnPreloadComplete;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SuraPreloadManifest.generated.h"
+
+/**
+ * Assets a level needs during gameplay that are not hard referenced by the level itself
+ * (weapon and projectile effects, sounds, icons, pooled enemy classes).
+ * Built in the editor with Sura.BuildPreloadManifest and loaded by USuraPreloadManager at level start.
+ */
+UCLASS(BlueprintType)
+class SURAS_API USuraPreloadManifest : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = "Preload")
+	TArray<FSoftObjectPath> Assets;
+
+#if WITH_EDITOR
+	// scans the placed weapon pick ups and object pools of the world
+	void BuildFromWorld(UWorld* World);
+#endif
+};
@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorComponents/WeaponSystem/WeaponName.h"
+#include "SuraBenchmarkManager.generated.h"
+
+class ASuraWeaponPickUp;
+class AObjectPool_Actor;
+class UInputAction;
+
+USTRUCT()
+struct FSuraBenchmarkScenario
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	EWeaponName WeaponName = EWeaponName::WeaponName_Rifle;
+
+	// acquired from the level's object pools, spread around the player
+	UPROPERTY()
+	int32 EnemyCount = 20;
+
+	UPROPERTY()
+	float SpawnRadius = 2000.f;
+
+	// seconds before recording starts, covers the weapon switch and enemies reaching the player
+	UPROPERTY()
+	float WarmUpTime = 3.f;
+
+	UPROPERTY()
+	float Duration = 30.f;
+
+	// the scripted player holds the weapon's input (fire, lock-on or charge) this long, then lets go for ReleaseTime
+	UPROPERTY()
+	float HoldTime = 2.f;
+
+	UPROPERTY()
+	float ReleaseTime = 0.5f;
+};
+
+/**
+ * Repeatable combat benchmark, started with -SuraBenchmark on a benchmark level (works headless with -nullrhi).
+ * Weapon pick ups are placed and picked up, and for each scenario enemies are acquired from the level's pools while a
+ * scripted player aims at the nearest one and drives the weapon through injected Enhanced Input actions, so the same
+ * bindings as in a real session are used. Every recorded frame goes to a CSV in <ProfilingDir>/SuraBenchmark, and the
+ * median, p95 and p99 of each metric are appended to Summary.csv for comparison across builds.
+ * -SuraBenchmark=<Name> runs a single scenario, and the game exits when the run is done.
+ */
+UCLASS(Config = Game)
+class SURAS_API USuraBenchmarkManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	enum class EPhase : uint8
+	{
+		Idle,
+		WarmUp,
+		Measure
+	};
+
+	struct FFrameSample
+	{
+		float FrameTime = 0.f;
+
+		float GameThreadTime = 0.f;
+
+		float GCTime = 0.f;
+
+		int32 Traces = 0;
+
+		int32 Actors = 0;
+
+		int32 Objects = 0;
+	};
+
+	TArray<FSuraBenchmarkScenario> ActiveScenarios;
+
+	int32 ScenarioIndex = INDEX_NONE;
+
+	EPhase Phase = EPhase::Idle;
+
+	float PhaseTime = 0.f;
+
+	float InputTime = 0.f;
+
+	// time since the last weapon switch was requested
+	float SwitchTime = 0.f;
+
+	// waiting for the player pawn before the pick ups are placed and the first scenario starts
+	bool bStartPending = false;
+
+	TWeakObjectPtr<const UInputAction> HeldAction;
+
+	struct FBenchmarkEnemy
+	{
+		TWeakObjectPtr<AObjectPool_Actor> Pool;
+
+		TWeakObjectPtr<APawn> Pawn;
+	};
+
+	TArray<FBenchmarkEnemy> Enemies;
+
+	TArray<FFrameSample> Samples;
+
+	double LastFrameTime = 0.0;
+
+	uint64 LastNumTraces = 0;
+
+	double GCStartTime = 0.0;
+
+	float PendingGCTime = 0.f;
+
+	FDelegateHandle PreGCHandle;
+
+	FDelegateHandle PostGCHandle;
+
+	FString RunName;
+
+	// [config]
+	UPROPERTY(Config)
+	TArray<FSuraBenchmarkScenario> Scenarios;
+
+	// one per weapon the scenarios use, placed next to the player and picked up before the first scenario
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<ASuraWeaponPickUp>> WeaponPickUpClasses;
+
+	void PlaceWeaponPickUps();
+
+	void StartScenario(int32 Index);
+
+	void FinishScenario();
+
+	// tops the live enemies back up to the scenario's count, killed ones return to their pool
+	void SpawnEnemies(const FSuraBenchmarkScenario& Scenario);
+
+	void ReleaseEnemies();
+
+	// switches weapons until the scenario's one is equipped, returns false while switching
+	bool EquipScenarioWeapon(const FSuraBenchmarkScenario& Scenario, float DeltaTime);
+
+	void AimAtNearestEnemy() const;
+
+	void UpdateScriptedInput(const FSuraBenchmarkScenario& Scenario, float DeltaTime);
+
+	void SetInputHeld(const UInputAction* Action, bool bHeld);
+
+	void PulseInput(const UInputAction* Action) const;
+
+	void RecordFrame(float FrameTime);
+
+	void WriteScenarioResults(const FSuraBenchmarkScenario& Scenario) const;
+
+	void OnPreGarbageCollect();
+
+	void OnPostGarbageCollect();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	FORCEINLINE bool IsRunning() const { return bStartPending || ScenarioIndex != INDEX_NONE; }
+};
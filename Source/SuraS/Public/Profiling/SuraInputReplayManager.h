@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InputActionValue.h"
+#include "SuraInputReplayManager.generated.h"
+
+class UInputAction;
+
+/**
+ * Records the player's Enhanced Input action values and the engine frame delta every frame, and replays them so a
+ * movement or combat run can be reproduced and profiled headless (-nullrhi).
+ * -SuraRecordInput=<Name> records from the first frame the player is possessed until the level ends or
+ * `Sura.StopInputRecording`. Every action of the applied mapping contexts is captured, which covers the player's own
+ * bindings, the weapon system's and the equipped weapon's.
+ * -SuraReplayInput=<Name> injects the recorded values back frame by frame, with the recorded deltas as a fixed time step,
+ * and exits when done. Both seed the random streams the same way, and a checksum of the player's location, velocity and
+ * control rotation every ChecksumInterval frames flags where the replay diverged from the recording.
+ * Files are <ProfilingDir>/SuraInput/<Name>.surainput.
+ */
+UCLASS(Config = Game)
+class SURAS_API USuraInputReplayManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	enum class EMode : uint8
+	{
+		None,
+		Record,
+		Replay
+	};
+
+	struct FRecordedValue
+	{
+		uint8 Action = 0;
+
+		EInputActionValueType ValueType = EInputActionValueType::Boolean;
+
+		FVector Value = FVector::ZeroVector;
+	};
+
+	// values are stored flat, a frame owns NumValues of them starting at FirstValue
+	struct FRecordedFrame
+	{
+		float DeltaTime = 0.f;
+
+		int32 FirstValue = 0;
+
+		uint8 NumValues = 0;
+
+		uint32 Checksum = 0;
+
+		FVector3f Location = FVector3f::ZeroVector;
+	};
+
+	EMode Mode = EMode::None;
+
+	// waiting for the player pawn, both modes start on the first tick it is possessed
+	bool bStartPending = false;
+
+	FString Filename;
+
+	int32 Seed = 0;
+
+	int32 RecordedChecksumInterval = 0;
+
+	UPROPERTY()
+	TArray<TObjectPtr<const UInputAction>> Actions;
+
+	TMap<const UInputAction*, uint8> ActionIndices;
+
+	TArray<FRecordedFrame> Frames;
+
+	TArray<FRecordedValue> Values;
+
+	// the replayed frame the engine is running, its values were injected on the previous tick
+	int32 FrameIndex = 0;
+
+	int32 NumChecksums = 0;
+
+	int32 NumDivergedChecksums = 0;
+
+	int32 FirstDivergedFrame = INDEX_NONE;
+
+	bool bWasUsingFixedTimeStep = false;
+
+	double PreviousFixedDeltaTime = 0.0;
+
+	// [config]
+	// frames between two checksums of the player state
+	UPROPERTY(Config)
+	int32 ChecksumInterval = 30;
+
+	void StartRecording();
+
+	void StartReplay();
+
+	void RecordFrame();
+
+	void ReplayFrame(int32 Index);
+
+	void FinishReplay();
+
+	uint8 GetActionIndex(const UInputAction* Action);
+
+	uint32 ComputeChecksum(FVector3f& OutLocation) const;
+
+	bool SaveRecording();
+
+	bool LoadRecording();
+
+	void SerializeRecording(FArchive& Ar);
+
+	static FString GetRecordingFilename(const FString& Name);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// writes the recording and stops, the level keeps running
+	void StopRecording();
+
+	FORCEINLINE bool IsRecording() const { return Mode == EMode::Record; }
+
+	FORCEINLINE bool IsReplaying() const { return Mode == EMode::Replay; }
+};
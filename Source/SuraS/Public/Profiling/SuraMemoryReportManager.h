@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SuraMemoryReportManager.generated.h"
+
+/**
+ * Counts the level's live gameplay objects per class (projectiles, decals, niagara and audio components, enemies,
+ * widgets, weapon render targets) with their estimated memory, and keeps the peak of both.
+ * `Sura.MemReport` dumps the current numbers to the log, and the soak test (`Sura.MemSoak` or -SuraMemSoak)
+ * appends them to a CSV at a fixed interval so objects that are never released show up as a steady climb.
+ * Native allocations are tagged per subsystem for LLM (-llm, `stat LLMFULL`), see SuraSStats.h.
+ */
+UCLASS(Config = Game)
+class SURAS_API USuraMemoryReportManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	struct FTrackedClass
+	{
+		const TCHAR* Subsystem = nullptr;
+
+		UClass* Class = nullptr;
+
+		int32 Count = 0;
+
+		int64 Bytes = 0;
+
+		int32 PeakCount = 0;
+
+		int64 PeakBytes = 0;
+	};
+
+	TArray<FTrackedClass> TrackedClasses;
+
+	// enemies owned by object pools, hidden ones included
+	int32 NumPooledEnemies = 0;
+
+	int32 PeakPooledEnemies = 0;
+
+	bool bSoakTestRunning = false;
+
+	float TimeSinceLastSample = 0.f;
+
+	FString SoakFilename;
+
+	// [config]
+	// seconds between two rows of the soak test CSV
+	UPROPERTY(Config)
+	float SoakSampleInterval = 30.f;
+
+	void TrackClass(const TCHAR* Subsystem, UClass* Class);
+
+	void Sample();
+
+	void WriteSoakRow() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	// samples and logs the current, peak and per class numbers
+	void DumpReport();
+
+	void StartSoakTest(float SampleInterval = 0.f);
+
+	void StopSoakTest();
+
+	FORCEINLINE bool IsSoakTestRunning() const { return bSoakTestRunning; }
+};
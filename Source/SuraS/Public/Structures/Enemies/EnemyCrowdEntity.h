@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Enumerations/Enemies/EEnemyState.h"
+#include "EnemyCrowdEntity.generated.h"
+
+class ASuraCharacterEnemyBase;
+
+/**
+ * Lightweight state of one far-away enemy owned by AEnemyCrowd_Actor.
+ * Only the data needed to move it and to hand it over to a full character is kept.
+ */
+USTRUCT()
+struct SURAS_API FEnemyCrowdEntity
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	// last location that was projected onto the navmesh successfully
+	UPROPERTY()
+	FVector NavLocation = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector Goal = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Speed = 0.f;
+
+	UPROPERTY()
+	float Health = 0.f;
+
+	UPROPERTY()
+	EEnemyState State = EEnemyState::Idle;
+
+	// index into AEnemyCrowd_Actor::CrowdTypes
+	UPROPERTY()
+	int32 TypeIndex = INDEX_NONE;
+
+	// instance of the type's instanced mesh, owned for the whole lifetime of the entity
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+
+	UPROPERTY()
+	bool bNeedsNewGoal = true;
+
+	// full character standing in for this entity while it is hydrated
+	UPROPERTY()
+	ASuraCharacterEnemyBase* HydratedEnemy = nullptr;
+
+	bool IsDead() const { return Health <= 0.f; }
+
+	bool IsHydrated() const { return HydratedEnemy != nullptr; }
+};
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyCrowdType.generated.h"
+
+class AObjectPool_Actor;
+class UStaticMesh;
+
+/**
+ * One kind of enemy handled by AEnemyCrowd_Actor.
+ * Health and speed come from the pooled enemy class' attribute data table.
+ */
+USTRUCT(BlueprintType)
+struct SURAS_API FEnemyCrowdType
+{
+	GENERATED_BODY()
+
+	// cheap far representation, e.g. a static mesh with a vertex animation material
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	UStaticMesh* Mesh = nullptr;
+
+	// pool providing the full characters this type hydrates into
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	AObjectPool_Actor* Pool = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 Count = 100;
+};
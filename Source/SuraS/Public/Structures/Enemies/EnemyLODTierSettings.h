@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyLODTierSettings.generated.h"
+
+/**
+ * Per-tier tick budget applied to an enemy by the significance manager.
+ * A tick interval of 0 means "every frame".
+ */
+USTRUCT(BlueprintType)
+struct SURAS_API FEnemyLODTierSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ActorTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bEnableMovementTick = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MovementTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AnimationTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float BehaviorTreeTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bEnablePerception = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bUpdateHealthBar = true;
+};
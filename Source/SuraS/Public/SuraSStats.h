@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+/**
+ * Gameplay profiling for SuraS: `stat SuraS` in game, and the "SuraS" trace channel in Unreal Insights
+ * (run with -trace=default,SuraS). Stats and trace scopes both compile out of Shipping builds.
+ *
+ * Cycle stats are declared next to the code they measure with DECLARE_CYCLE_STAT(..., STATGROUP_SuraS)
+ * and opened with SURAS_SCOPE_CYCLE_COUNTER, which also emits a named trace event on the SuraS channel.
+ */
+DECLARE_STATS_GROUP(TEXT("SuraS"), STATGROUP_SuraS, STATCAT_Advanced);
+
+// live object counts
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Projectiles"), STAT_SuraLiveProjectiles, STATGROUP_SuraS, SURAS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Enemies"), STAT_SuraLiveEnemies, STATGROUP_SuraS, SURAS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Widgets Created"), STAT_SuraWidgetsCreated, STATGROUP_SuraS, SURAS_API);
+
+// shared by every behavior tree task, each task also opens a trace scope named after itself
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AI Task ExecuteTask"), STAT_SuraAITaskExecute, STATGROUP_SuraS, SURAS_API);
+
+// per frame counts, reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_SuraTraces, STATGROUP_SuraS, SURAS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectiles Spawned"), STAT_SuraProjectilesSpawned, STATGROUP_SuraS, SURAS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI Task Executions"), STAT_SuraAITaskExecutions, STATGROUP_SuraS, SURAS_API);
+
+// every gameplay scene query is counted with SURAS_COUNT_TRACE rather than STAT_SuraTraces directly,
+// anything else that needs the count hooks in here instead of at the call sites
+#if !UE_BUILD_SHIPPING
+// running total readable without stats (e.g. by the benchmark), game thread only
+extern SURAS_API uint64 GSuraNumTraces;
+
+#define SURAS_COUNT_TRACE() \
+	do { INC_DWORD_STAT(STAT_SuraTraces); ++GSuraNumTraces; } while (0)
+#else
+#define SURAS_COUNT_TRACE()
+#endif
+
+// LLM tags per gameplay subsystem, shown as SuraS/<Subsystem> with -llm (`stat LLMFULL`, -llmcsv).
+// Open them with LLM_SCOPE_BYTAG where the subsystem spawns or creates its objects, they compile out without LLM.
+LLM_DECLARE_TAG_API(SuraS_Weapons, SURAS_API);
+LLM_DECLARE_TAG_API(SuraS_Projectiles, SURAS_API);
+LLM_DECLARE_TAG_API(SuraS_FX, SURAS_API);
+LLM_DECLARE_TAG_API(SuraS_Enemies, SURAS_API);
+LLM_DECLARE_TAG_API(SuraS_UI, SURAS_API);
+
+#if !UE_BUILD_SHIPPING
+UE_TRACE_CHANNEL_EXTERN(SuraSChannel, SURAS_API);
+
+#define SURAS_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, SuraSChannel)
+
+// trace-only scope for code that isn't worth a stat of its own
+#define SURAS_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, SuraSChannel)
+#else
+#define SURAS_SCOPE_CYCLE_COUNTER(Stat)
+#define SURAS_TRACE_SCOPE(Name)
+#endif
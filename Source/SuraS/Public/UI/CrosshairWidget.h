@@ -9,7 +9,7 @@
 /**
  * 
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class SURAS_API UCrosshairWidget : public UBaseUIWidget
 {
 	GENERATED_BODY()
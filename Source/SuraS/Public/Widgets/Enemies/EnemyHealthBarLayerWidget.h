@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Widgets/Enemies/EnemyHealthBarWidget.h"
+#include "EnemyHealthBarLayerWidget.generated.h"
+
+class ASuraCharacterEnemyBase;
+class UCanvasPanel;
+
+/**
+ * Single HUD layer drawing the health bars of all recently damaged enemies.
+ * Bars are pooled UEnemyHealthBarWidget elements placed with render transforms from one batched projection per frame.
+ * Enemies only push their health percent when it changes.
+ */
+UCLASS()
+class SURAS_API UEnemyHealthBarLayerWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+	struct FHealthBarEntry
+	{
+		TWeakObjectPtr<ASuraCharacterEnemyBase> Enemy;
+
+		UEnemyHealthBarWidget* Widget = nullptr;
+
+		float HideTime = 0.f;
+	};
+
+	// built in code when the layer isn't created from a widget blueprint
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional, AllowPrivateAccess = "true"))
+	UCanvasPanel* HealthBarCanvas = nullptr;
+
+	UPROPERTY()
+	TSubclassOf<UEnemyHealthBarWidget> HealthBarWidgetClass;
+
+	// every element ever created, free ones stay in the canvas collapsed
+	UPROPERTY()
+	TArray<UEnemyHealthBarWidget*> HealthBarWidgets;
+
+	UPROPERTY()
+	TArray<UEnemyHealthBarWidget*> FreeHealthBarWidgets;
+
+	TArray<FHealthBarEntry> Entries;
+
+	FVector2D HealthBarSize = FVector2D::ZeroVector;
+
+	FHealthBarEntry* FindEntry(const ASuraCharacterEnemyBase* Enemy);
+
+	UEnemyHealthBarWidget* AcquireHealthBarWidget();
+
+	void ReleaseHealthBarWidget(UEnemyHealthBarWidget* Widget);
+
+protected:
+	virtual bool Initialize() override;
+
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	// seconds a bar stays up after the enemy was last damaged
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
+	float DisplayDuration = 1.f;
+
+	// offset from the enemy's location the bar is anchored to
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
+	FVector WorldOffset = FVector(0.f, 0.f, 1.f);
+
+	// bars keep their design size at this distance and scale inversely with it, within the clamp below
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
+	float ReferenceDistance = 500.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Health Bar")
+	FVector2D DistanceClamp = FVector2D(100.f, 1000.f);
+
+public:
+	void SetHealthBarWidgetClass(TSubclassOf<UEnemyHealthBarWidget> NewHealthBarWidgetClass);
+
+	// shows (or keeps showing) the enemy's bar and pushes its current percent
+	void ShowHealthBar(ASuraCharacterEnemyBase* Enemy, float Percent);
+
+	// pushes the percent only if the enemy's bar is currently up
+	void UpdateHealthBar(const ASuraCharacterEnemyBase* Enemy, float Percent);
+
+	void HideHealthBar(const ASuraCharacterEnemyBase* Enemy);
+};
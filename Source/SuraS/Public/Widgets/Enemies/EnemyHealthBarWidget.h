@@ -11,7 +11,7 @@
 /**
  * 
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class SURAS_API UEnemyHealthBarWidget : public UUserWidget
 {
 	GENERATED_BODY()
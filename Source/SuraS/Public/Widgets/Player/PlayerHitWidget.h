@@ -10,7 +10,7 @@
 /**
  * 
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class SURAS_API UPlayerHitWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -23,4 +23,7 @@ class SURAS_API UPlayerHitWidget : public UUserWidget
 
 public:
 	void PlayFadeAnimtion();
+
+protected:
+	virtual void OnAnimationFinished_Implementation(const UWidgetAnimation* Animation) override;
 };